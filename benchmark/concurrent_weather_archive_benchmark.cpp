@@ -0,0 +1,100 @@
+/**
+ * @file concurrent_weather_archive_benchmark.cpp
+ * @date 10/16/2026
+ *
+ * @brief Benchmark for the throughput of ConcurrentWeatherArchive under a mixed
+ * read and write load
+ *
+ * Reader threads retrieve random dates while a single writer thread adds data, and
+ * the number of reads and writes completed in a fixed duration is reported.
+ */
+
+#include "data/weather_data.h"
+#include "data/concurrent_weather_archive.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    /** @brief Number of data points in the archive before the benchmark starts */
+    constexpr int InitialLength = 50000;
+
+    /** @brief Duration of each benchmark run */
+    constexpr auto RunDuration = std::chrono::seconds(1);
+
+    /** @brief Create a data point for the i-th day */
+    WeatherData createData(const int i) {
+        WeatherData data;
+        data.time = i * WeatherData::DaySeconds;
+        data.maxTemp = 20.0f + i % 10;
+        data.minTemp = 5.0f + i % 7;
+        data.meanTemp = 12.5f + i % 5;
+        data.gas_ppt = 0.1f * (i % 3);
+        return data;
+    }
+
+    /**
+     * @brief Run readers and a writer concurrently and print their throughput
+     * @param[in] reader_count Number of reader threads
+     * @param[in] batch_size Batch size of the archive
+     */
+    void runBenchmark(const int reader_count, const std::size_t batch_size) {
+        WeatherArchive initial;
+        for (auto i = 0; i < InitialLength; ++i) {
+            initial.addData(createData(i));
+        }
+        ConcurrentWeatherArchive archive(std::move(initial), batch_size);
+
+        std::atomic<bool> running {true};
+        std::atomic<long long> reads {0};
+        std::vector<std::thread> readers;
+        for (auto r = 0; r < reader_count; ++r) {
+            readers.emplace_back([&, r]() {
+                std::mt19937 generator(r);
+                std::uniform_int_distribution<int> day(0, InitialLength - 1);
+                long long readCount = 0;
+                while (running.load(std::memory_order_relaxed)) {
+                    if (archive.retrieve(day(generator) * WeatherData::DaySeconds).has_value()) {
+                        ++readCount;
+                    }
+                }
+                reads += readCount;
+            });
+        }
+
+        long long writes = 0;
+        const auto finish = std::chrono::steady_clock::now() + RunDuration;
+        while (std::chrono::steady_clock::now() < finish) {
+            archive.addData(createData(InitialLength + static_cast<int>(writes)));
+            ++writes;
+        }
+        archive.publish();
+        running = false;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        const auto seconds = std::chrono::duration<double>(RunDuration).count();
+        std::cout << reader_count << " readers, batch size " << batch_size << ": "
+            << reads.load() / seconds << " reads/s, "
+            << writes / seconds << " writes/s, "
+            << archive.version() << " versions published\n";
+    }
+}
+
+int main() {
+    // leave one core for the writer
+    const int maxReaders = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    for (const auto batchSize : {256, 4096}) {
+        for (auto readers = 1; readers <= maxReaders; readers *= 2) {
+            runBenchmark(readers, batchSize);
+        }
+    }
+
+    return 0;
+}
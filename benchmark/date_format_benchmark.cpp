@@ -0,0 +1,77 @@
+/**
+ * @file date_format_benchmark.cpp
+ * @date 10/16/2026
+ *
+ * @brief Benchmark for formatting Unix times as YYYY-MM-DD dates
+ *
+ * Compares jsonparse::unixToDate, which returns a std::string, against
+ * jsonparse::formatDate, which writes into a caller provided buffer, and against
+ * formatting with the date library through a std::ostringstream
+ */
+
+#include "json_parse.h"
+#include "data/weather_data.h"
+
+#include "date/date.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+    /** @brief Number of dates to format, roughly 270 years of daily data */
+    constexpr int DateCount = 100000;
+
+    /** @brief Number of times each benchmark is repeated, the fastest time is reported */
+    constexpr int Repetitions = 3;
+
+    /**
+     * @brief Time a function that formats every date
+     * @param[in] name Name of the benchmark to display
+     * @param[in] format Function that formats a Unix time, returning a checksum of the
+     * characters written so the work cannot be optimized away
+     */
+    void runBenchmark(const std::string& name,
+            const std::function<std::size_t(std::chrono::seconds::rep)>& format) {
+        auto fastest = std::chrono::nanoseconds::max();
+        std::size_t checksum = 0;
+        for (auto i = 0; i < Repetitions; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            for (auto day = 0; day < DateCount; ++day) {
+                checksum += format(day * WeatherData::DaySeconds);
+            }
+            const auto finish = std::chrono::steady_clock::now();
+            fastest = std::min(fastest,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start));
+        }
+
+        std::cout << name << ": "
+            << std::chrono::duration<double, std::milli>(fastest).count() << " ms"
+            << " (checksum " << checksum << ")\n";
+    }
+}
+
+int main() {
+    std::cout << "Formatting " << DateCount << " dates (fastest of "
+        << Repetitions << " runs)\n";
+
+    runBenchmark("date library with ostringstream", [](const std::chrono::seconds::rep time) {
+        std::ostringstream buffer;
+        buffer << date::year_month_day{date::floor<date::days>(
+                date::sys_seconds{std::chrono::seconds(time)})};
+        return static_cast<std::size_t>(buffer.str()[9]);
+    });
+    runBenchmark("unixToDate", [](const std::chrono::seconds::rep time) {
+        return static_cast<std::size_t>(jsonparse::unixToDate(time)[9]);
+    });
+    runBenchmark("formatDate", [](const std::chrono::seconds::rep time) {
+        char buffer[jsonparse::DateLength];
+        jsonparse::formatDate(time, buffer);
+        return static_cast<std::size_t>(buffer[9]);
+    });
+
+    return 0;
+}
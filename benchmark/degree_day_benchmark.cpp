@@ -0,0 +1,142 @@
+/**
+ * @file degree_day_benchmark.cpp
+ * @date 10/16/2026
+ *
+ * @brief Benchmark for summing degree days with the DegreeDayIndex class
+ *
+ * Ranges within a single month are summed by the vectorized kernel of DegreeDayIndex,
+ * so querying them is compared against summing the same ranges with a scalar loop.
+ * Ranges spanning many months, which are summed from the monthly prefix sums, are
+ * also timed.
+ */
+
+#include "data/degree_day_index.h"
+#include "data/weather_columns.h"
+#include "data/weather_data.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /** @brief Number of data points, roughly 100 years of hourly data */
+    constexpr int DataLength = 876000;
+
+    /** @brief Number of ranges queried */
+    constexpr int QueryCount = 100000;
+
+    /** @brief Number of times each benchmark is repeated, the fastest time is reported */
+    constexpr int Repetitions = 3;
+
+    /** @brief Seconds in an hour */
+    constexpr WeatherData::data_time HourSeconds = 3600;
+
+    /** @brief Base temperature of the degree days */
+    constexpr float Base = 18.0f;
+
+    /** @brief Create hourly weather data, sorted by time, with some temperatures missing */
+    std::vector<WeatherData> createData() {
+        std::vector<WeatherData> data(DataLength);
+        for (auto i = 0; i < DataLength; ++i) {
+            data[i].time = i * HourSeconds;
+            if (i % 13 != 0) {
+                data[i].meanTemp = 5.0f + static_cast<float>(i % 29);
+            }
+        }
+        return data;
+    }
+
+    /**
+     * @brief Time a function
+     * @param[in] name Name of the benchmark to display
+     * @param[in] run Function to time, returning a checksum of its results so the work
+     * cannot be optimized away
+     */
+    void runBenchmark(const std::string& name, const std::function<double()>& run) {
+        auto fastest = std::chrono::nanoseconds::max();
+        double checksum = 0;
+        for (auto i = 0; i < Repetitions; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            checksum = run();
+            const auto finish = std::chrono::steady_clock::now();
+            fastest = std::min(fastest,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start));
+        }
+
+        std::cout << name << ": "
+            << std::chrono::duration<double, std::milli>(fastest).count() << " ms"
+            << " (checksum " << checksum << ")\n";
+    }
+
+    /**
+     * @brief Sum the degree days of [first, last) with the scalar loop DegreeDayIndex
+     * used before its kernel was vectorized (baseline)
+     */
+    double scalarDegreeDays(const std::vector<float>& temperatures, const std::size_t first,
+            const std::size_t last) {
+        double heating = 0;
+        double cooling = 0;
+        std::size_t count = 0;
+        for (auto i = first; i < last; ++i) {
+            const auto temperature = temperatures[i];
+            heating += std::max(0.0f, Base - temperature);
+            cooling += std::max(0.0f, temperature - Base);
+            count += (temperature == temperature);
+        }
+        return heating + cooling + static_cast<double>(count);
+    }
+}
+
+int main() {
+    const WeatherColumns columns(createData());
+    const auto& temperatures = columns.values(WeatherData::Variable::MeanTemp);
+    const auto monthStarts = columns.monthStarts();
+    const DegreeDayIndex index(std::make_shared<const DegreeDayIndex::Temperatures>(columns), Base);
+
+    // ranges within a random month, and ranges between random positions
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> months(0, monthStarts.size() - 2);
+    std::uniform_int_distribution<std::size_t> position(0, DataLength);
+    std::vector<std::pair<std::size_t, std::size_t>> monthRanges(QueryCount);
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(QueryCount);
+    for (auto i = 0; i < QueryCount; ++i) {
+        const auto month = months(generator);
+        std::uniform_int_distribution<std::size_t> day(monthStarts[month], monthStarts[month + 1]);
+        monthRanges[i] = std::minmax(day(generator), day(generator));
+        ranges[i] = std::minmax(position(generator), position(generator));
+    }
+
+    const auto queryAll = [&index](const std::vector<std::pair<std::size_t, std::size_t>>& queries) {
+        double checksum = 0;
+        for (const auto& [first, last] : queries) {
+            const auto totals = index.query(first, last);
+            checksum += totals.heating + totals.cooling + static_cast<double>(totals.count);
+        }
+        return checksum;
+    };
+
+    std::cout << "Summing degree days of " << QueryCount << " ranges of " << DataLength
+        << " hourly data points (fastest of " << Repetitions << " runs)\n";
+    runBenchmark("scalar loop, ranges within a month (baseline)", [&]() {
+        double checksum = 0;
+        for (const auto& [first, last] : monthRanges) {
+            checksum += scalarDegreeDays(temperatures, first, last);
+        }
+        return checksum;
+    });
+    runBenchmark("DegreeDayIndex::query, ranges within a month", [&]() {
+        return queryAll(monthRanges);
+    });
+    runBenchmark("DegreeDayIndex::query, random ranges", [&]() {
+        return queryAll(ranges);
+    });
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file json_output_benchmark.cpp
+ * @date 10/16/2026
+ *
+ * @brief Benchmark for writing weather data as a JSON Array
+ *
+ * Compares jsonPretty of a Json::Value array (the original --range output), writing
+ * createWeatherJson of each data point with JsonArrayWriter, and writing the weather
+ * data directly with JsonArrayWriter
+ */
+
+#include "json_parse.h"
+#include "data/weather_data.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /** @brief Number of data points to write, roughly 270 years of daily data */
+    constexpr int DataLength = 100000;
+
+    /** @brief Number of times each benchmark is repeated, the fastest time is reported */
+    constexpr int Repetitions = 3;
+
+    /** @brief Create daily weather data with millidegree values */
+    std::vector<WeatherData> createData() {
+        std::vector<WeatherData> data(DataLength);
+        for (auto i = 0; i < DataLength; ++i) {
+            data[i].time = i * WeatherData::DaySeconds;
+            data[i].maxTemp = static_cast<float>(20000 + (i * 37) % 15000) / 1000.0f;
+            data[i].minTemp = static_cast<float>(-5000 + (i * 53) % 15000) / 1000.0f;
+            data[i].meanTemp = static_cast<float>(5000 + (i * 71) % 15000) / 1000.0f;
+            data[i].gas_ppt = static_cast<float>((i * 13) % 500) / 100.0f;
+        }
+        return data;
+    }
+
+    /**
+     * @brief Time a function that writes the data
+     * @param[in] name Name of the benchmark to display
+     * @param[in] data The data to write
+     * @param[in] write Function that writes the data to a stream
+     * @return The output of the last run
+     */
+    std::string runBenchmark(const std::string& name,
+            const std::vector<WeatherData>& data,
+            const std::function<void(std::ostream&, const std::vector<WeatherData>&)>& write) {
+        auto fastest = std::chrono::nanoseconds::max();
+        std::string output;
+        for (auto i = 0; i < Repetitions; ++i) {
+            std::ostringstream out;
+            const auto start = std::chrono::steady_clock::now();
+            write(out, data);
+            const auto finish = std::chrono::steady_clock::now();
+            fastest = std::min(fastest,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start));
+            output = out.str();
+        }
+
+        std::cout << name << ": "
+            << std::chrono::duration<double, std::milli>(fastest).count() << " ms\n";
+        return output;
+    }
+}
+
+int main() {
+    const auto data = createData();
+    std::cout << "Writing " << DataLength << " data points (fastest of "
+        << Repetitions << " runs)\n";
+
+    const auto pretty = runBenchmark("jsonPretty of array", data,
+            [](std::ostream& out, const std::vector<WeatherData>& data) {
+        Json::Value array = Json::arrayValue;
+        for (const auto& weatherData : data) {
+            array.append(jsonparse::createWeatherJson(weatherData));
+        }
+        out << jsonparse::jsonPretty(array);
+    });
+    const auto values = runBenchmark("JsonArrayWriter, Json::Value", data,
+            [](std::ostream& out, const std::vector<WeatherData>& data) {
+        jsonparse::JsonArrayWriter writer(out);
+        for (const auto& weatherData : data) {
+            writer.write(jsonparse::createWeatherJson(weatherData));
+        }
+        writer.close();
+    });
+    const auto direct = runBenchmark("JsonArrayWriter, WeatherData", data,
+            [](std::ostream& out, const std::vector<WeatherData>& data) {
+        jsonparse::JsonArrayWriter writer(out);
+        for (const auto& weatherData : data) {
+            writer.write(weatherData);
+        }
+        writer.close();
+    });
+
+    if (values != pretty || direct != pretty) {
+        std::cerr << "Outputs do not match\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file weather_archive_benchmark.cpp
+ * @date 10/16/2026
+ *
+ * @brief Benchmark for loading data into the WeatherArchive class
+ *
+ * Compares adding data one point at a time with WeatherArchive::addData
+ * against adding it at once with WeatherArchive::addBatch. Appending with addData
+ * is also compared to appending to a std::vector, and to appending while the
+ * indexes are periodically rebuilt by queries, so per point overhead of addData
+ * (such as clearing cached indexes) shows up against the baseline.
+ */
+
+#include "data/weather_data.h"
+#include "data/weather_archive.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    /** @brief Number of data points to load, roughly 270 years of daily data */
+    constexpr int DataLength = 100000;
+
+    /** @brief Number of times each benchmark is repeated, the fastest time is reported */
+    constexpr int Repetitions = 3;
+
+    /** @brief Number of data points added between queries of the interleaved benchmark */
+    constexpr int QueryInterval = 10000;
+
+    /** @brief Create daily weather data, sorted by time */
+    std::vector<WeatherData> createData() {
+        std::vector<WeatherData> data(DataLength);
+        for (auto i = 0; i < DataLength; ++i) {
+            data[i].time = i * WeatherData::DaySeconds;
+            data[i].maxTemp = 20.0f + i % 10;
+            data[i].minTemp = 5.0f + i % 7;
+            data[i].meanTemp = 12.5f + i % 5;
+            data[i].gas_ppt = 0.1f * (i % 3);
+        }
+        return data;
+    }
+
+    /**
+     * @brief Time a function that loads an archive
+     * @param[in] name Name of the benchmark to display
+     * @param[in] load Function that loads the data into the archive
+     * @param[in] check_size Check that the archive holds the data after loading
+     */
+    void runBenchmark(const std::string& name,
+            const std::vector<WeatherData>& data,
+            const std::function<void(WeatherArchive&, std::vector<WeatherData>&&)>& load,
+            const bool check_size = true) {
+        auto fastest = std::chrono::nanoseconds::max();
+        for (auto i = 0; i < Repetitions; ++i) {
+            auto copy = data; // copy outside of the timed section
+            WeatherArchive archive;
+            const auto start = std::chrono::steady_clock::now();
+            load(archive, std::move(copy));
+            const auto finish = std::chrono::steady_clock::now();
+            fastest = std::min(fastest,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start));
+
+            if (check_size && archive.size() != DataLength) {
+                std::cerr << name << ": archive contains " << archive.size()
+                    << " data points, expected " << DataLength << "\n";
+            }
+        }
+
+        std::cout << name << ": "
+            << std::chrono::duration<double, std::milli>(fastest).count() << " ms\n";
+    }
+}
+
+int main() {
+    const auto sortedData = createData();
+    auto shuffledData = sortedData;
+    std::shuffle(shuffledData.begin(), shuffledData.end(), std::mt19937{0});
+
+    std::cout << "Loading " << DataLength << " data points (fastest of "
+        << Repetitions << " runs)\n";
+
+    const auto addEach = [](WeatherArchive& archive, std::vector<WeatherData>&& data) {
+        for (const auto& weatherData : data) {
+            archive.addData(weatherData);
+        }
+    };
+    const auto addBatch = [](WeatherArchive& archive, std::vector<WeatherData>&& data) {
+        archive.addBatch(std::move(data));
+    };
+
+    // baseline for appending, addData of sorted input should stay close to this
+    const auto pushBack = [](WeatherArchive&, std::vector<WeatherData>&& data) {
+        std::vector<WeatherData> copy;
+        for (const auto& weatherData : data) {
+            copy.push_back(weatherData);
+        }
+        if (copy.size() != data.size()) {
+            std::cerr << "push_back lost data\n"; // keeps the loop from being optimized away
+        }
+    };
+    const auto addEachWithQueries = [](WeatherArchive& archive, std::vector<WeatherData>&& data) {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            archive.addData(data[i]);
+            if (i % QueryInterval == QueryInterval - 1) {
+                archive.retrieveMax(WeatherData::Variable::MaxTemp, 0, data[i].time.value());
+            }
+        }
+    };
+
+    runBenchmark("std::vector::push_back, sorted input (baseline)", sortedData, pushBack, false);
+    runBenchmark("addData, sorted input", sortedData, addEach);
+    runBenchmark("addData, sorted input, query every " + std::to_string(QueryInterval) + " points",
+            sortedData, addEachWithQueries);
+    runBenchmark("addBatch, sorted input", sortedData, addBatch);
+    runBenchmark("addData, shuffled input", shuffledData, addEach);
+    runBenchmark("addBatch, shuffled input", shuffledData, addBatch);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file arrow_stream_writer.h
+ * @date 10/16/2026
+ *
+ * @brief ArrowStreamWriter class declaration
+ */
+
+#ifndef ARROW_STREAM_WRITER_H
+#define ARROW_STREAM_WRITER_H
+
+#include "data/weather_columns.h"
+#include "data/weather_data.h"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @class ArrowStreamWriter arrow_stream_writer.h "arrow_stream_writer.h"
+ * @brief Write weather data in the Apache Arrow IPC streaming format, without the
+ * Arrow library, so it can be read by Arrow readers (ex. pyarrow.ipc.open_stream)
+ * without parsing.
+ *
+ * The stream is a schema message, followed by record batches of at most BatchSize
+ * rows, followed by the end of stream marker. The columns are "date" (date32, days
+ * since 1970-01-01) and "ppt", "tmax", "tmean", "tmin" (float32), each with a validity
+ * bitmap marking missing data as null. Values are written in the byte order of the
+ * host, which the schema declares as little endian.
+ */
+class ArrowStreamWriter {
+public:
+
+    /** @brief Maximum number of rows of a record batch */
+    static constexpr std::size_t BatchSize = 65536;
+
+    /**
+     * @brief Constructor, writes the schema message
+     * @param[in] out Stream to write to, which must outlive the writer. It should be
+     * opened in binary mode
+     */
+    explicit ArrowStreamWriter(std::ostream& out);
+
+    /**
+     * @brief Write a data point. Data points are held until BatchSize of them can be
+     * written as a record batch, or the writer is closed
+     * @param[in] data The weather data
+     */
+    void write(const WeatherData& data);
+
+    /**
+     * @brief Write data points straight from column storage, as record batches.
+     * Measurements are written from the columns without being copied
+     * @param[in] columns Column storage of the weather data
+     * @param[in] first Position of the first data point to write
+     * @param[in] last Position after the last data point to write
+     */
+    void write(const WeatherColumns& columns, const std::size_t first, const std::size_t last);
+
+    /**
+     * @brief Write the data points that are held, and the end of stream marker.
+     * Nothing may be written after closing the writer
+     */
+    void close();
+
+private:
+
+    /**
+     * @brief Write a record batch message
+     * @param[in] length Number of rows
+     * @param[in] days Days since 1970-01-01 of each row
+     * @param[in] date_valid For each row, 0 if its date is missing, or nullptr if no
+     * date is missing
+     * @param[in] values Measurements of each variable (indexed by WeatherData::Variable)
+     * for each row, NaN where the measurement is missing
+     */
+    void writeBatch(
+            const std::size_t length,
+            const std::int32_t* days,
+            const std::uint8_t* date_valid,
+            const std::array<const float*, WeatherData::VariableCount>& values);
+
+    /** @brief Write the held data points as a record batch, if there are any */
+    void flush();
+
+    std::ostream& mOut; /**<@brief Stream the data is written to */
+
+    std::vector<std::int32_t> mDays; /**<@brief Days of the held data points */
+    std::vector<std::uint8_t> mDateValid; /**<@brief Held data points that have a date */
+    /**@brief Measurements of the held data points, indexed by WeatherData::Variable */
+    std::array<std::vector<float>, WeatherData::VariableCount> mValues;
+
+};
+#endif // ARROW_STREAM_WRITER_H
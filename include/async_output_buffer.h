@@ -0,0 +1,102 @@
+/**
+ * @file async_output_buffer.h
+ * @date 10/16/2026
+ *
+ * @brief AsyncOutputBuffer class declaration
+ */
+
+#ifndef ASYNC_OUTPUT_BUFFER_H
+#define ASYNC_OUTPUT_BUFFER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class AsyncOutputBuffer async_output_buffer.h "async_output_buffer.h"
+ * @brief A stream buffer that writes to a file descriptor from a dedicated writer thread.
+ *
+ * Output is formatted into large blocks. A full block is handed to the writer thread,
+ * and formatting continues into the next free block while the full one is written, so
+ * formatting overlaps the write. Blocks that are handed over while a write is in
+ * progress are written together with a single writev call.
+ *
+ * Once a write fails (ex. the reading end of a pipe is closed), later output is
+ * discarded and the stream using the buffer fails.
+ */
+class AsyncOutputBuffer : public std::streambuf {
+public:
+
+    /** @brief Default size of each block, in bytes */
+    static constexpr std::size_t DefaultBlockSize = 1 << 20;
+
+    /** @brief Default number of blocks */
+    static constexpr std::size_t DefaultBlockCount = 4;
+
+    /**
+     * @brief Constructor that starts the writer thread
+     * @param[in] fd File descriptor to write to (ex. STDOUT_FILENO), which must stay open
+     * while the buffer exists. It is not closed by the buffer
+     * @param[in] block_size Size of each block, in bytes. If 0, 1 is used
+     * @param[in] block_count Number of blocks. If less than 2, 2 are used (double buffering)
+     */
+    explicit AsyncOutputBuffer(
+            const int fd,
+            const std::size_t block_size = DefaultBlockSize,
+            const std::size_t block_count = DefaultBlockCount);
+
+    /** @brief Destructor that writes the remaining output, then joins the writer thread */
+    ~AsyncOutputBuffer() override;
+
+    AsyncOutputBuffer(const AsyncOutputBuffer&) = delete;
+    AsyncOutputBuffer& operator= (const AsyncOutputBuffer&) = delete;
+
+protected:
+
+    /**
+     * @brief Hand the full block to the writer thread and continue in a free block
+     * @param[in] ch Character that did not fit in the full block, or EOF
+     * @return ch, or EOF if a write failed
+     */
+    int_type overflow(int_type ch) override;
+
+    /**
+     * @brief Hand the current block to the writer thread, and wait until all output
+     * has been written
+     * @return 0, or -1 if a write failed
+     */
+    int sync() override;
+
+private:
+
+    /**
+     * @brief Hand the current block to the writer thread if it is not empty, and set the
+     * put area to a free block
+     * @param[in] lock Lock of mMutex, held while waiting for a free block
+     */
+    void handOff(std::unique_lock<std::mutex>& lock);
+
+    /** @brief Function run by the writer thread */
+    void run();
+
+    const int mFd; /**<@brief File descriptor written to */
+
+    std::vector<std::vector<char>> mBlocks; /**<@brief Memory of each block */
+    std::size_t mCurrent {0}; /**<@brief Block that output is formatted into */
+
+    std::mutex mMutex; /**<@brief Guards the members below */
+    std::condition_variable mChanged; /**<@brief Notified when the members below change */
+    /**@brief Blocks waiting to be written, with the number of bytes of each */
+    std::deque<std::pair<std::size_t, std::size_t>> mPending;
+    std::vector<std::size_t> mFree; /**<@brief Blocks that are neither current nor being written */
+    bool mFailed {false}; /**<@brief A write has failed */
+    bool mStop {false}; /**<@brief The writer thread should stop once mPending is empty */
+
+    std::thread mWriter; /**<@brief The writer thread, started last */
+
+};
+#endif // ASYNC_OUTPUT_BUFFER_H
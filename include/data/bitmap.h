@@ -0,0 +1,79 @@
+/**
+ * @file bitmap.h
+ * @date 10/16/2026
+ *
+ * @brief Bitmap class declaration
+ */
+
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @class Bitmap bitmap.h "data/bitmap.h"
+ * @brief A compressed set of positions, in the style of a roaring bitmap.
+ *
+ * Positions are split into chunks of 65536 by their upper 16 bits. A chunk with few
+ * positions stores them as a sorted array of their lower 16 bits, and a chunk with many
+ * positions stores a 65536 bit bitset, so sparse and dense sets are both compact.
+ * Counting positions within a range uses popcount on whole words of a bitset.
+ */
+class Bitmap {
+public:
+
+    /** @brief Largest number of positions a chunk stores as an array */
+    static constexpr std::size_t ArrayLimit = 4096;
+
+    /**
+     * @brief Add a position, which must be larger than every position already added
+     * @param[in] position The position
+     */
+    void append(const std::uint32_t position);
+
+    /**
+     * @brief Count the positions within a range
+     * @param[in] first The first position of the range
+     * @param[in] last Position past the end of the range
+     * @return The number of positions within [first, last)
+     */
+    std::size_t count(const std::uint32_t first, const std::uint32_t last) const;
+
+    /**
+     * @brief Visit the positions within a range in increasing order
+     * @param[in] first The first position of the range
+     * @param[in] last Position past the end of the range
+     * @param[in] visitor Function called with each position within [first, last)
+     */
+    void forEach(const std::uint32_t first,
+            const std::uint32_t last,
+            const std::function<void(std::uint32_t)>& visitor) const;
+
+private:
+
+    /** @brief The positions that share the same upper 16 bits */
+    struct Chunk {
+        std::uint16_t key; /**<@brief Upper 16 bits of the positions */
+        /**@brief Sorted lower 16 bits of the positions, if the chunk is an array */
+        std::vector<std::uint16_t> array;
+        /**@brief Bitset of the lower 16 bits, 1024 words if the chunk is a bitset */
+        std::vector<std::uint64_t> bits;
+        std::size_t size {0}; /**<@brief Number of positions within the chunk */
+
+        /** @return True if the positions are stored as a bitset */
+        bool isBitset() const { return !bits.empty(); }
+
+        /** @brief Add a position's lower 16 bits to the chunk, storing it as a bitset if it is large */
+        void add(const std::uint16_t low);
+
+        /** @return The number of positions with lower 16 bits within [first, last) */
+        std::size_t count(const std::uint32_t first, const std::uint32_t last) const;
+    };
+
+    std::vector<Chunk> mChunks; /**<@brief Non-empty chunks, sorted by key */
+
+};
+#endif // BITMAP_H
@@ -0,0 +1,78 @@
+/**
+ * @file climatology_normals.h
+ * @date 10/16/2026
+ *
+ * @brief ClimatologyNormals class declaration
+ */
+
+#ifndef CLIMATOLOGY_NORMALS_H
+#define CLIMATOLOGY_NORMALS_H
+
+#include "data/weather_columns.h"
+#include "data/weather_summary.h"
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @class ClimatologyNormals climatology_normals.h "data/climatology_normals.h"
+ * @brief The climatological normals of weather data over a range of years: a
+ * WeatherSummary of every calendar day (month and day), taken over all years of the range.
+ *
+ * For example, the mean tmax of March 14 over 1991-2020 is the mean of the tmax of the
+ * 30 March 14ths within the range. February 29 only summarizes leap years.
+ * The table is built in a single pass over the columns of the data.
+ */
+class ClimatologyNormals {
+public:
+
+    /** @brief The number of calendar days, including February 29 */
+    static constexpr std::size_t DayCount = 366;
+
+    /**
+     * @brief Build the normals of a range of years
+     * @param[in] columns The weather data as columns
+     * @param[in] first_year The first year of the range
+     * @param[in] last_year The last year of the range (inclusive). If it is before
+     * first_year, the normals are empty.
+     */
+    ClimatologyNormals(const WeatherColumns& columns, const int first_year, const int last_year);
+
+    /** @return The first year of the range */
+    int firstYear() const;
+
+    /** @return The last year of the range */
+    int lastYear() const;
+
+    /**
+     * @brief Get the normals of a calendar day
+     * @param[in] month The month (1-12)
+     * @param[in] day The day of the month (1-31)
+     * @throws std::out_of_range if the month and day are not a day of a leap year
+     * @return Summary of the data of the day, over all years of the range
+     */
+    const WeatherSummary& day(const unsigned month, const unsigned day) const noexcept(false);
+
+    /**
+     * @brief Get the normals of every calendar day
+     * @return Summaries indexed by dayIndex, January 1st first
+     */
+    const std::array<WeatherSummary, DayCount>& days() const;
+
+    /**
+     * @brief Get the index of a calendar day within days(), counting as in a leap year
+     * @param[in] month The month (1-12)
+     * @param[in] day The day of the month (1-31)
+     * @return The index (0 for January 1st, 59 for February 29th, 365 for December 31st),
+     * or DayCount if the month and day are not a day of a leap year
+     */
+    static std::size_t dayIndex(const unsigned month, const unsigned day);
+
+private:
+
+    int mFirstYear; /**<@brief First year of the range */
+    int mLastYear; /**<@brief Last year of the range */
+    std::array<WeatherSummary, DayCount> mDays; /**<@brief Summary of each calendar day */
+
+};
+#endif // CLIMATOLOGY_NORMALS_H
@@ -0,0 +1,108 @@
+/**
+ * @file concurrent_weather_archive.h
+ * @date 10/16/2026
+ *
+ * @brief ConcurrentWeatherArchive class declaration
+ */
+
+#ifndef CONCURRENT_WEATHER_ARCHIVE_H
+#define CONCURRENT_WEATHER_ARCHIVE_H
+
+#include "data/weather_data.h"
+#include "data/weather_archive.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/**
+ * @class ConcurrentWeatherArchive concurrent_weather_archive.h "data/concurrent_weather_archive.h"
+ * @brief A thread-safe WeatherArchive that allows data to be added while other threads
+ * retrieve data.
+ *
+ * Readers operate on an immutable, published version (snapshot) of the archive, so reads
+ * never wait for writes. Added data is collected into a pending batch, and published as a
+ * new version of the archive once the batch is full (or publish is called). Publishing copies
+ * the current version, so batching amortizes its cost over many added data points.
+ * A snapshot remains valid and unchanged for as long as a reader holds it.
+ */
+class ConcurrentWeatherArchive {
+public:
+
+    /** @brief An immutable version of the archive */
+    using Snapshot = std::shared_ptr<const WeatherArchive>;
+
+    /** @brief Default number of pending data points that triggers publishing a new version */
+    static constexpr std::size_t DefaultBatchSize = 1024;
+
+    /**
+     * @brief Constructor
+     * @param[in] archive Initial data of the archive
+     * @param[in] batch_size Number of pending data points that triggers publishing a
+     * new version. A batch_size of 0 or 1 publishes every added data point.
+     */
+    explicit ConcurrentWeatherArchive(
+            WeatherArchive archive = WeatherArchive(),
+            const std::size_t batch_size = DefaultBatchSize);
+
+    /**
+     * @brief Get the latest published version of the archive. Never waits for writers.
+     * @return Snapshot of the archive
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Retrieve a single data point from the latest published version
+     * See WeatherArchive::retrieve
+     */
+    std::optional<WeatherData> retrieve(const WeatherData::data_time time) const;
+
+    /**
+     * @brief Retrieve data within a time range from the latest published version
+     * See WeatherArchive::retrieveRange
+     */
+    std::vector<WeatherData> retrieveRange(
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Add a data point to the pending batch, publishing a new version if the
+     * batch is full. See WeatherArchive::addData
+     * @param[in] data Weather data to add
+     */
+    void addData(const WeatherData& data);
+
+    /**
+     * @brief Add data points to the pending batch, and publish a new version
+     * See WeatherArchive::addBatch
+     * @param[in] data Weather data to add
+     */
+    void addBatch(std::vector<WeatherData>&& data);
+
+    /** @brief Publish a new version containing all pending data, if there is any */
+    void publish();
+
+    /** @return The number of versions published since construction */
+    std::uint64_t version() const;
+
+private:
+
+    /** @brief Publish the pending data. mWriterMutex must be held */
+    void publishLocked();
+
+    /**
+     * @brief The latest published version.
+     * Only accessed with std::atomic_load and std::atomic_store
+     */
+    Snapshot mpPublished;
+
+    std::mutex mWriterMutex; /**<@brief Serializes writers, never held by readers */
+    std::vector<WeatherData> mPending; /**<@brief Data waiting to be published */
+    const std::size_t mBatchSize; /**<@brief Pending size that triggers publishing */
+    std::atomic<std::uint64_t> mVersion {0}; /**<@brief Number of published versions */
+
+};
+#endif // CONCURRENT_WEATHER_ARCHIVE_H
@@ -0,0 +1,72 @@
+/**
+ * @file counter_random.h
+ * @date 10/16/2026
+ *
+ * @brief CounterRandom class declaration
+ */
+
+#ifndef COUNTER_RANDOM_H
+#define COUNTER_RANDOM_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @class CounterRandom counter_random.h "data/counter_random.h"
+ * @brief A counter based random number generator (Philox4x32-10)
+ *
+ * Unlike std::mt19937, there is no state that advances with each draw: the random bits
+ * of a counter are a pure function of (seed, counter, stream). Draws can therefore be
+ * made in any order, or split between threads, and give the same result as drawing
+ * them one after another.
+ */
+class CounterRandom {
+public:
+
+    /** @brief The random bits of a counter */
+    using Block = std::array<std::uint32_t, 4>;
+
+    /**
+     * @brief Constructor
+     * @param[in] seed The seed, which is used as the key of the generator
+     */
+    explicit CounterRandom(const std::uint64_t seed);
+
+    /** @return The seed */
+    std::uint64_t seed() const;
+
+    /**
+     * @brief Generate the random bits of a counter
+     * @param[in] counter The counter, ex. the number of the day being drawn
+     * @param[in] stream An independent stream of counters, ex. the member of an ensemble
+     * @return 128 random bits
+     */
+    Block generate(const std::uint64_t counter, const std::uint64_t stream = 0) const;
+
+    /**
+     * @brief Draw a uniformly distributed integer
+     * @param[in] counter The counter
+     * @param[in] n The number of possible values, which must not be 0
+     * @param[in] stream The stream
+     * @return An integer in [0, n)
+     */
+    std::uint32_t uniform(
+            const std::uint64_t counter,
+            const std::uint32_t n,
+            const std::uint64_t stream = 0) const;
+
+    /**
+     * @brief Map 32 random bits to a uniformly distributed integer in [0, n), by
+     * multiplying instead of dividing. The bias is below n / 2^32.
+     * @param[in] bits Random bits
+     * @param[in] n The number of possible values
+     * @return An integer in [0, n)
+     */
+    static std::uint32_t scale(const std::uint32_t bits, const std::uint32_t n);
+
+private:
+
+    std::uint64_t mSeed; /**<@brief The seed (key) of the generator */
+
+};
+#endif // COUNTER_RANDOM_H
@@ -0,0 +1,79 @@
+/**
+ * @file degree_day_index.h
+ * @date 10/16/2026
+ *
+ * @brief DegreeDayIndex class declaration
+ */
+
+#ifndef DEGREE_DAY_INDEX_H
+#define DEGREE_DAY_INDEX_H
+
+#include "data/weather_columns.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class DegreeDayIndex degree_day_index.h "data/degree_day_index.h"
+ * @brief Answers heating and cooling degree day totals over any range of time ordered
+ * data, for a base temperature.
+ *
+ * The temperature of a day is its mean temperature, or the average of its maximum and
+ * minimum temperature if the mean is missing. Days without either are skipped.
+ * The totals of every calendar month are accumulated when the index is built, so a
+ * range sums the months it covers from prefix sums, and only the days of the partial
+ * months at its ends are visited. The temperatures do not depend on the base, so they
+ * are built once and shared by the indexes of every base, which only hold their
+ * monthly prefix sums.
+ */
+class DegreeDayIndex {
+public:
+
+    /** @brief Degree day totals of a range */
+    struct DegreeDays {
+        double heating {0}; /**<@brief Sum of max(0, base - temperature) */
+        double cooling {0}; /**<@brief Sum of max(0, temperature - base) */
+        std::size_t count {0}; /**<@brief Number of days with a temperature */
+    };
+
+    /** @brief The temperature of each data point, and where each month begins */
+    struct Temperatures {
+        /**
+         * @brief Find the temperature of each data point
+         * @param[in] columns The weather data as columns
+         */
+        explicit Temperatures(const WeatherColumns& columns);
+
+        std::vector<float> values; /**<@brief Temperature of each day, NaN if missing */
+        /**@brief Position of the first data point of each month, then the number of data points */
+        std::vector<std::size_t> monthStarts;
+    };
+
+    /**
+     * @brief Build the index
+     * @param[in] temperatures The temperatures, shared with the indexes of other bases
+     * @param[in] base The base temperature, in Celcius
+     */
+    DegreeDayIndex(std::shared_ptr<const Temperatures> temperatures, const float base);
+
+    /**
+     * @brief Find the degree day totals of a range
+     * @param[in] first Position of the first data point of the range
+     * @param[in] last Position past the last data point of the range
+     * @return The totals of the range
+     */
+    DegreeDays query(const std::size_t first, const std::size_t last) const;
+
+private:
+
+    /** @brief Sum the degree days of [first, last) of the temperatures */
+    DegreeDays accumulate(const std::size_t first, const std::size_t last) const;
+
+    float mBase; /**<@brief Base temperature */
+    std::shared_ptr<const Temperatures> mTemperatures; /**<@brief Temperatures of the data */
+    /**@brief Totals of all months before each month, then of all months */
+    std::vector<DegreeDays> mMonthPrefix;
+
+};
+#endif // DEGREE_DAY_INDEX_H
@@ -0,0 +1,167 @@
+/**
+ * @file historical_sampler.h
+ * @date 10/16/2026
+ *
+ * @brief HistoricalSampler class declaration
+ */
+
+#ifndef HISTORICAL_SAMPLER_H
+#define HISTORICAL_SAMPLER_H
+
+#include "data/weather_columns.h"
+#include "data/climatology_normals.h"
+#include "data/counter_random.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @class HistoricalSampler historical_sampler.h "data/historical_sampler.h"
+ * @brief Samples historical weather data: the data of a date is taken from the same
+ * calendar day of a year chosen at random from a range of years.
+ *
+ * The positions of the data of every calendar day within the year range are found once,
+ * so each draw is O(1). The draw for a date only depends on the seed and the date (see
+ * CounterRandom), so a range of dates can be sampled on any number of threads with the
+ * same result.
+ *
+ * Sampling each date independently loses the persistence of weather from one day to the
+ * next, so dates may instead be sampled in blocks (a block bootstrap): the first date of a
+ * block is drawn as usual, and the following dates of the block take the data of the days
+ * following the drawn day, from the same year. Dates of a block whose following day is
+ * missing, or outside the year range, are drawn on their own.
+ *
+ * Years may be weighted, ex. so that recent years are drawn more often. The weighted draw
+ * of each calendar day uses an alias table (Walker's method) of the years with its data,
+ * so it is O(1) for any number of years.
+ */
+class HistoricalSampler {
+public:
+
+    /** @brief Position returned for a date without any data to sample */
+    static constexpr std::size_t NoData = std::numeric_limits<std::size_t>::max();
+
+    /** @brief Number of dates sampled by a thread at a time */
+    static constexpr std::size_t ChunkSize = 4096;
+
+    /**
+     * @brief Constructor
+     * @param[in] columns The weather data as columns
+     * @param[in] first_year The first year to sample from
+     * @param[in] last_year The last year to sample from (inclusive)
+     * @param[in] year_weights Relative weight of each year, first_year first. Years without
+     * a positive weight are never drawn. If empty, every year has the same weight
+     */
+    HistoricalSampler(
+            const WeatherColumns& columns,
+            const int first_year,
+            const int last_year,
+            const std::vector<double>& year_weights = {});
+
+    /**
+     * @brief Get the number of years that have data for a calendar day and can be drawn
+     * @param[in] month The month (1-12)
+     * @param[in] day The day of the month (1-31)
+     * @return The number of years, 0 if the month and day are not a calendar day
+     */
+    std::size_t available(const unsigned month, const unsigned day) const;
+
+    /**
+     * @brief Sample a date
+     * @param[in] random The generator
+     * @param[in] day_number The date, as days since 1970-01-01
+     * @param[in] member The member of an ensemble of samples, each member is drawn from an
+     * independent stream of the generator
+     * @return Position of the sampled data within the columns, or NoData if no year
+     * has data for the calendar day of the date
+     */
+    std::size_t draw(
+            const CounterRandom& random,
+            const std::int64_t day_number,
+            const std::uint64_t member = 0) const;
+
+    /**
+     * @brief Sample every date of a range of dates
+     * @param[in] random The generator
+     * @param[in] first_day The first date, as days since 1970-01-01
+     * @param[in] day_count The number of dates
+     * @param[in] thread_count Number of threads to use, which does not change the result
+     * @param[in] member The member of an ensemble of samples (see draw)
+     * @param[in] block_length The number of consecutive days sampled from the same year,
+     * beginning at first_day. 1 samples every date independently.
+     * @return Position of the sampled data of each date (see draw)
+     */
+    std::vector<std::size_t> sample(
+            const CounterRandom& random,
+            const std::int64_t first_day,
+            const std::size_t day_count,
+            const std::size_t thread_count = 1,
+            const std::uint64_t member = 0,
+            const std::size_t block_length = 1) const;
+
+private:
+
+    /**
+     * @brief Sample a date within a block
+     * @param[in] random The generator
+     * @param[in] block_day The first date of the block, as days since 1970-01-01
+     * @param[in] offset The number of days of the date after block_day
+     * @param[in] member The member of an ensemble of samples
+     * @return Position of the sampled data, or NoData
+     */
+    std::size_t drawInBlock(
+            const CounterRandom& random,
+            const std::int64_t block_day,
+            const std::int64_t offset,
+            const std::uint64_t member) const;
+
+    /**
+     * @brief Draw the day of the data of a date
+     * @param[in] random The generator
+     * @param[in] day_number The date, as days since 1970-01-01
+     * @param[in] member The member of an ensemble of samples
+     * @return The drawn day, counting from mFirstDay, or NoDay
+     */
+    std::uint32_t drawDay(
+            const CounterRandom& random,
+            const std::int64_t day_number,
+            const std::uint64_t member) const;
+
+    /**
+     * @brief Get the year of a day
+     * @param[in] day The day, counting from mFirstDay
+     * @return The year
+     */
+    int yearOf(const std::uint32_t day) const;
+
+    /** @brief Acceptance of an alias table column that is never aliased, 2^32 */
+    static constexpr std::uint64_t AcceptanceScale = std::uint64_t{1} << 32;
+
+    /** @brief Day returned by drawDay for a date without any data to sample */
+    static constexpr std::uint32_t NoDay = std::numeric_limits<std::uint32_t>::max();
+
+    std::int64_t mFirstDay {0}; /**<@brief January 1st of the first year, as days since 1970-01-01 */
+
+    /**@brief Position of the data of each day of the year range, counting from mFirstDay,
+     * or NoData */
+    std::vector<std::size_t> mDayPositions;
+
+    /**@brief Where the days of each calendar day begin within mDays, indexed by
+     * ClimatologyNormals::dayIndex, followed by the size of mDays */
+    std::array<std::uint32_t, ClimatologyNormals::DayCount + 1> mOffsets {};
+
+    /**@brief Days (counting from mFirstDay) with data of each calendar day, in year order */
+    std::vector<std::uint32_t> mDays;
+
+    /**@brief Alias table acceptance of each column, parallel to mDays: a column is drawn
+     * if 32 random bits are below it, otherwise its alias is. Empty if years are unweighted */
+    std::vector<std::uint64_t> mAcceptance;
+
+    /**@brief Alias of each column within its calendar day, parallel to mDays */
+    std::vector<std::uint32_t> mAlias;
+
+};
+#endif // HISTORICAL_SAMPLER_H
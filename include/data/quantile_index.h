@@ -0,0 +1,67 @@
+/**
+ * @file quantile_index.h
+ * @date 10/16/2026
+ *
+ * @brief QuantileIndex class declaration
+ */
+
+#ifndef QUANTILE_INDEX_H
+#define QUANTILE_INDEX_H
+
+#include "data/weather_data.h"
+#include "data/weather_columns.h"
+#include "data/quantile_sketch.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @class QuantileIndex quantile_index.h "data/quantile_index.h"
+ * @brief Answers quantile (percentile) queries of a variable over any range of time
+ * ordered data.
+ *
+ * Ranges with at most ExactLimit data points are answered exactly by selecting from
+ * their values. Longer ranges are estimated with a QuantileSketch: a sketch of every
+ * calendar month is built with the index, so a long range merges the sketches of the
+ * months it covers and only adds the values of the partial months at its ends.
+ */
+class QuantileIndex {
+public:
+
+    /** @brief The largest range, in data points, that is answered exactly */
+    static constexpr std::size_t ExactLimit = 4096;
+
+    /**
+     * @brief Build the index
+     * @param[in] columns The weather data as columns, which the index shares instead of
+     * copying the indexed column
+     * @param[in] variable The indexed variable
+     */
+    QuantileIndex(std::shared_ptr<const WeatherColumns> columns, const WeatherData::Variable variable);
+
+    /**
+     * @brief Find a quantile of the variable's measurements within a range
+     * @param[in] first Position of the first data point of the range
+     * @param[in] last Position past the last data point of the range
+     * @param[in] fraction The quantile, from 0 (minimum) to 1 (maximum)
+     * @return The quantile (nearest rank), or the optional will not be set if no data
+     * within the range has the variable
+     */
+    std::optional<float> query(
+            const std::size_t first,
+            const std::size_t last,
+            const double fraction) const;
+
+private:
+
+    /**@brief The weather data as columns, kept so mValues stays valid without a copy */
+    std::shared_ptr<const WeatherColumns> mColumns;
+    const std::vector<float>& mValues; /**<@brief Indexed measurements, NaN if missing */
+    /**@brief Position of the first data point of each month, then the number of data points */
+    std::vector<std::size_t> mMonthStarts;
+    std::vector<QuantileSketch> mMonthSketches; /**<@brief Sketch of each month's measurements */
+
+};
+#endif // QUANTILE_INDEX_H
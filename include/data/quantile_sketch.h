@@ -0,0 +1,77 @@
+/**
+ * @file quantile_sketch.h
+ * @date 10/16/2026
+ *
+ * @brief QuantileSketch class declaration
+ */
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/**
+ * @class QuantileSketch quantile_sketch.h "data/quantile_sketch.h"
+ * @brief A mergeable KLL sketch that estimates quantiles of a stream of values using
+ * O(k) memory.
+ *
+ * Values are kept in levels, where a value at level h stands for 2^h of the original
+ * values. When the sketch is full, the lowest full level is sorted and every other value
+ * is promoted to the next level. The rank error of a quantile is about 1.7 / k of the
+ * number of values. Which half is promoted alternates, instead of being random, so a
+ * sketch built from the same values is always the same.
+ */
+class QuantileSketch {
+public:
+
+    /** @brief Default accuracy parameter, giving a rank error below 1% */
+    static constexpr std::size_t DefaultK = 200;
+
+    /**
+     * @brief Constructor of an empty sketch
+     * @param[in] k Accuracy parameter, the size of the largest level
+     */
+    explicit QuantileSketch(const std::size_t k = DefaultK);
+
+    /**
+     * @brief Add a value to the sketch
+     * @param[in] value The value
+     */
+    void add(const float value);
+
+    /**
+     * @brief Add the values of another sketch to this sketch
+     * @param[in] other The other sketch
+     */
+    void merge(const QuantileSketch& other);
+
+    /** @return The number of values added to the sketch */
+    std::size_t count() const;
+
+    /**
+     * @brief Estimate a quantile of the values
+     * @param[in] fraction The quantile, from 0 (minimum) to 1 (maximum)
+     * @return The smallest value whose rank is at least fraction of the values, or the
+     * optional will not be set if the sketch is empty
+     */
+    std::optional<float> quantile(const double fraction) const;
+
+private:
+
+    /** @return The capacity of a level, which shrinks geometrically below the top level */
+    std::size_t capacity(const std::size_t level) const;
+
+    /** @brief Compact levels until the sketch is within its capacity */
+    void compress();
+
+    std::size_t mK; /**<@brief Accuracy parameter */
+    std::size_t mCount {0}; /**<@brief Number of values added */
+    std::size_t mSize {0}; /**<@brief Number of values stored in all levels */
+    std::size_t mCompactions {0}; /**<@brief Number of compactions, chooses the promoted half */
+    /**@brief Stored values of each level, a value at level h has a weight of 2^h */
+    std::vector<std::vector<float>> mLevels;
+
+};
+#endif // QUANTILE_SKETCH_H
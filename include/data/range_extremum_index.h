@@ -0,0 +1,74 @@
+/**
+ * @file range_extremum_index.h
+ * @date 10/16/2026
+ *
+ * @brief RangeExtremumIndex class declaration
+ */
+
+#ifndef RANGE_EXTREMUM_INDEX_H
+#define RANGE_EXTREMUM_INDEX_H
+
+#include "data/weather_columns.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @class RangeExtremumIndex range_extremum_index.h "data/range_extremum_index.h"
+ * @brief A sparse table that finds the minimum or maximum of any range of a variable's
+ * column in O(1).
+ *
+ * Level k of the table holds the position of the extremum of every range of length 2^k,
+ * so any range is covered by two (overlapping) ranges of the same level.
+ * NaN values are treated as missing and skipped. When values are tied, the earliest
+ * position is returned. Building the table is O(n log n) in time and memory.
+ */
+class RangeExtremumIndex {
+public:
+
+    /** @brief Which extremum the index finds */
+    enum class Extremum {
+        Min, /**<@brief The smallest value */
+        Max /**<@brief The largest value */
+    };
+
+    /**
+     * @brief Build the index
+     * @param[in] columns The weather data as columns, which the index shares instead of
+     * copying the indexed column. NaN denotes a missing value
+     * @param[in] variable The indexed variable
+     * @param[in] extremum Which extremum to find
+     */
+    RangeExtremumIndex(
+            std::shared_ptr<const WeatherColumns> columns,
+            const WeatherData::Variable variable,
+            const Extremum extremum);
+
+    /**
+     * @brief Find the position of the extremum within a range
+     * @param[in] first Position of the first value of the range
+     * @param[in] last Position past the last value of the range
+     * @return Position of the extremum, or the optional will not be set if the range
+     * is empty or all of its values are missing
+     */
+    std::optional<std::size_t> query(const std::size_t first, const std::size_t last) const;
+
+private:
+
+    /**
+     * @brief Choose the better of two positions
+     * @return lhs if its value is at least as extreme as rhs's value, otherwise rhs
+     */
+    std::uint32_t better(const std::uint32_t lhs, const std::uint32_t rhs) const;
+
+    /**@brief The weather data as columns, kept so mValues stays valid without a copy */
+    std::shared_ptr<const WeatherColumns> mColumns;
+    const std::vector<float>& mValues; /**<@brief Indexed values, a column of mColumns */
+    Extremum mExtremum; /**<@brief Which extremum is found */
+    /**@brief mTable[k][i] is the position of the extremum of [i, i + 2^k) */
+    std::vector<std::vector<std::uint32_t>> mTable;
+
+};
+#endif // RANGE_EXTREMUM_INDEX_H
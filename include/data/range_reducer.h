@@ -0,0 +1,55 @@
+/**
+ * @file range_reducer.h
+ * @date 10/16/2026
+ *
+ * @brief RangeReducer class declaration
+ */
+
+#ifndef RANGE_REDUCER_H
+#define RANGE_REDUCER_H
+
+#include "data/weather_summary.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class RangeReducer range_reducer.h "data/range_reducer.h"
+ * @brief Summarizes (count, sum, min, max) a range of a column of measurements on
+ * multiple threads.
+ *
+ * The range is split into blocks of BlockSize values, which worker threads claim one
+ * at a time until none are left, so a slow thread never holds up the others. The block
+ * summaries are then merged pairwise in a fixed tree. Since the blocks and the tree only
+ * depend on the range, the result is bit for bit the same for any number of threads.
+ */
+class RangeReducer {
+public:
+
+    /** @brief Number of values in a block, small enough for a block to stay in cache */
+    static constexpr std::size_t BlockSize = 8192;
+
+    /**
+     * @brief Constructor
+     * @param[in] thread_count Number of threads to use. If 0, a single thread is used.
+     */
+    explicit RangeReducer(const std::size_t thread_count);
+
+    /**
+     * @brief Summarize a range of values
+     * @param[in] values Values to summarize, NaN denoting a missing value
+     * @param[in] first Position of the first value of the range
+     * @param[in] last Position past the last value of the range
+     * @return Summary of the values within the range that are not missing
+     */
+    VariableSummary reduce(
+            const std::vector<float>& values,
+            const std::size_t first,
+            const std::size_t last) const;
+
+private:
+
+    std::size_t mThreadCount; /**<@brief Number of threads to use */
+
+};
+#endif // RANGE_REDUCER_H
@@ -0,0 +1,64 @@
+/**
+ * @file rolling_window.h
+ * @date 10/16/2026
+ *
+ * @brief RollingWindow class declaration
+ */
+
+#ifndef ROLLING_WINDOW_H
+#define ROLLING_WINDOW_H
+
+#include "data/weather_data.h"
+#include "data/weather_columns.h"
+#include "data/weather_summary.h"
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @class RollingWindow rolling_window.h "data/rolling_window.h"
+ * @brief Computes a moving count, mean, minimum and maximum of a variable in a single
+ * pass over time ordered data.
+ *
+ * The window of a data point covers the window length of time ending at (and including)
+ * the data point, so missing days simply leave fewer measurements within the window.
+ * Sliding the window by one data point is amortized O(1): the sum and count are kept
+ * running, and the minimum and maximum are kept by monotonic queues of positions.
+ */
+class RollingWindow {
+public:
+
+    /**
+     * @brief Constructor
+     * @param[in] columns The weather data as columns, which must outlive the window
+     * @param[in] variable The variable to aggregate
+     * @param[in] window_sec Length of the window in seconds (ex. 7 days is 604800)
+     */
+    RollingWindow(
+            const WeatherColumns& columns,
+            const WeatherData::Variable variable,
+            const WeatherData::data_time window_sec);
+
+    /**
+     * @brief Slide the window over every data point within a time range. Data before the
+     * range is included in the windows of the first data points of the range.
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] visitor Function called with the time of each data point within the range,
+     * and the summary of the variable's measurements within its window. The summary's
+     * count is 0 if the window has no measurements.
+     * @return The number of data points visited
+     */
+    std::size_t slide(
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const std::function<void(WeatherData::data_time, const VariableSummary&)>& visitor) const;
+
+private:
+
+    const WeatherColumns& mColumns; /**<@brief The weather data */
+    WeatherData::Variable mVariable; /**<@brief The aggregated variable */
+    WeatherData::data_time mWindowSec; /**<@brief Length of the window */
+
+};
+#endif // ROLLING_WINDOW_H
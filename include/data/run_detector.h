@@ -0,0 +1,72 @@
+/**
+ * @file run_detector.h
+ * @date 10/16/2026
+ *
+ * @brief RunDetector class declaration
+ */
+
+#ifndef RUN_DETECTOR_H
+#define RUN_DETECTOR_H
+
+#include "data/weather_data.h"
+#include "data/weather_columns.h"
+#include "data/value_bitmap_index.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class RunDetector run_detector.h "data/run_detector.h"
+ * @brief Finds runs of consecutive days whose measurement of a variable meets a condition,
+ * such as heat waves (tmax > 35 for at least 3 days) or dry spells (ppt = 0 for at least
+ * 10 days).
+ *
+ * A missing day, or a day missing the variable, ends a run, since it is unknown whether
+ * it met the condition. The condition of every data point is evaluated in one pass over
+ * the variable's column, then runs are found in a second pass over the result.
+ */
+class RunDetector {
+public:
+
+    /** @brief A run of consecutive days that meet the condition */
+    struct Run {
+        std::size_t first; /**<@brief Position of the first day of the run */
+        std::size_t last; /**<@brief Position of the last day of the run */
+        std::size_t length; /**<@brief Number of days in the run */
+        /**@brief Position of the peak of the run: the largest measurement, or the smallest
+         * for a Less or LessEqual condition (the earliest if tied) */
+        std::size_t peak;
+    };
+
+    /**
+     * @brief Constructor
+     * @param[in] columns The weather data as columns, with at most one data point per day,
+     * which must outlive the detector
+     */
+    explicit RunDetector(const WeatherColumns& columns);
+
+    /**
+     * @brief Find the runs within a range
+     * @param[in] variable The variable of the condition
+     * @param[in] comparison How measurements are compared to the threshold
+     * @param[in] threshold The threshold
+     * @param[in] min_length The minimum number of days of a run
+     * @param[in] first Position of the first data point of the range
+     * @param[in] last Position past the last data point of the range
+     * @return The runs within the range, in time order. A run is cut off at the ends of
+     * the range.
+     */
+    std::vector<Run> detect(
+            const WeatherData::Variable variable,
+            const ValueBitmapIndex::Comparison comparison,
+            const float threshold,
+            const std::size_t min_length,
+            const std::size_t first,
+            const std::size_t last) const;
+
+private:
+
+    const WeatherColumns& mColumns; /**<@brief The weather data */
+
+};
+#endif // RUN_DETECTOR_H
@@ -0,0 +1,69 @@
+/**
+ * @file sorted_value_index.h
+ * @date 10/16/2026
+ *
+ * @brief SortedValueIndex class declaration
+ */
+
+#ifndef SORTED_VALUE_INDEX_H
+#define SORTED_VALUE_INDEX_H
+
+#include "data/range_extremum_index.h"
+#include "data/weather_columns.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class SortedValueIndex sorted_value_index.h "data/sorted_value_index.h"
+ * @brief Finds the k most extreme values within a range of a variable's column.
+ *
+ * The index holds the positions of the values sorted from most to least extreme. For a
+ * range covering much of the array, the sorted positions are walked until k of them
+ * fall within the range. For a short range, where few sorted positions would fall within
+ * it, the range is partially sorted instead. NaN values are treated as missing and
+ * skipped. When values are tied, the earliest position ranks first.
+ */
+class SortedValueIndex {
+public:
+
+    /**
+     * @brief Build the index
+     * @param[in] columns The weather data as columns, which the index shares instead of
+     * copying the indexed column. NaN denotes a missing value
+     * @param[in] variable The indexed variable
+     * @param[in] extremum Which extremum ranks first
+     */
+    SortedValueIndex(
+            std::shared_ptr<const WeatherColumns> columns,
+            const WeatherData::Variable variable,
+            const RangeExtremumIndex::Extremum extremum);
+
+    /**
+     * @brief Find the positions of the most extreme values within a range
+     * @param[in] k The number of values to find
+     * @param[in] first Position of the first value of the range
+     * @param[in] last Position past the last value of the range
+     * @return Up to k positions, most extreme first
+     */
+    std::vector<std::size_t> top(
+            const std::size_t k,
+            const std::size_t first,
+            const std::size_t last) const;
+
+private:
+
+    /** @return True if the value at lhs ranks before the value at rhs */
+    bool before(const std::size_t lhs, const std::size_t rhs) const;
+
+    /**@brief The weather data as columns, kept so mValues stays valid without a copy */
+    std::shared_ptr<const WeatherColumns> mColumns;
+    const std::vector<float>& mValues; /**<@brief Indexed values, a column of mColumns */
+    RangeExtremumIndex::Extremum mExtremum; /**<@brief Which extremum ranks first */
+    /**@brief Positions of the values that are not missing, most extreme first */
+    std::vector<std::uint32_t> mSorted;
+
+};
+#endif // SORTED_VALUE_INDEX_H
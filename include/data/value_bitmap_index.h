@@ -0,0 +1,105 @@
+/**
+ * @file value_bitmap_index.h
+ * @date 10/16/2026
+ *
+ * @brief ValueBitmapIndex class declaration
+ */
+
+#ifndef VALUE_BITMAP_INDEX_H
+#define VALUE_BITMAP_INDEX_H
+
+#include "data/bitmap.h"
+#include "data/weather_columns.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ValueBitmapIndex value_bitmap_index.h "data/value_bitmap_index.h"
+ * @brief A bitmap index of a variable's column, for counting and finding the values
+ * that compare to a threshold within a range of positions.
+ *
+ * Values are quantized into bins of about equal size, and a compressed Bitmap holds the
+ * positions of the values of each bin. For each bin boundary, another Bitmap holds the
+ * positions of the values at or above the boundary, so the values of any run of whole
+ * bins are counted from two bitmaps. Only the values of the single bin containing the
+ * threshold are compared to it.
+ * NaN values are treated as missing and never match.
+ */
+class ValueBitmapIndex {
+public:
+
+    /** @brief Number of bins the values are quantized into */
+    static constexpr std::size_t BinCount = 64;
+
+    /** @brief How values are compared to the threshold */
+    enum class Comparison {
+        Less, /**<@brief value < threshold */
+        LessEqual, /**<@brief value <= threshold */
+        Equal, /**<@brief value == threshold */
+        GreaterEqual, /**<@brief value >= threshold */
+        Greater /**<@brief value > threshold */
+    };
+
+    /**
+     * @brief Build the index
+     * @param[in] columns The weather data as columns, which the index shares instead of
+     * copying the indexed column. NaN denotes a missing value
+     * @param[in] variable The indexed variable
+     */
+    ValueBitmapIndex(std::shared_ptr<const WeatherColumns> columns, const WeatherData::Variable variable);
+
+    /**
+     * @brief Count the values within a range that compare to a threshold
+     * @param[in] comparison How values are compared to the threshold
+     * @param[in] threshold The threshold
+     * @param[in] first Position of the first value of the range
+     * @param[in] last Position past the last value of the range
+     * @return The number of matching values
+     */
+    std::size_t count(const Comparison comparison,
+            const float threshold,
+            const std::size_t first,
+            const std::size_t last) const;
+
+    /**
+     * @brief Find the values within a range that compare to a threshold
+     * @param[in] comparison How values are compared to the threshold
+     * @param[in] threshold The threshold
+     * @param[in] first Position of the first value of the range
+     * @param[in] last Position past the last value of the range
+     * @return Positions of the matching values, in increasing order
+     */
+    std::vector<std::size_t> find(const Comparison comparison,
+            const float threshold,
+            const std::size_t first,
+            const std::size_t last) const;
+
+private:
+
+    /** @brief The bins answering a threshold query */
+    struct Plan {
+        std::size_t firstBin {0}; /**<@brief First bin whose values all match */
+        std::size_t lastBin {0}; /**<@brief Bin past the last bin whose values all match */
+        /**@brief Bin whose values must be compared to the threshold, or BinCount if none */
+        std::size_t partialBin {BinCount};
+    };
+
+    /** @brief Choose the bins that answer a threshold query */
+    Plan plan(const Comparison comparison, const float threshold) const;
+
+    /** @return True if a value compares to the threshold */
+    static bool matches(const Comparison comparison, const float value, const float threshold);
+
+    /**@brief The weather data as columns, kept so mValues stays valid without a copy */
+    std::shared_ptr<const WeatherColumns> mColumns;
+    const std::vector<float>& mValues; /**<@brief Indexed values, a column of mColumns */
+    std::vector<float> mBoundaries; /**<@brief Smallest value of each bin, increasing */
+    /**@brief mAtLeast[i] holds the positions of values >= mBoundaries[i], then an empty bitmap */
+    std::vector<Bitmap> mAtLeast;
+    std::vector<Bitmap> mBins; /**<@brief mBins[i] holds the positions of the values of bin i */
+
+};
+#endif // VALUE_BITMAP_INDEX_H
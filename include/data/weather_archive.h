@@ -9,9 +9,30 @@
 #define WEATHER_ARCHIVE_H
 
 #include "data/weather_data.h"
+#include "data/weather_columns.h"
+#include "data/range_extremum_index.h"
+#include "data/weather_rollup.h"
+#include "data/climatology_normals.h"
+#include "data/rolling_window.h"
+#include "data/range_reducer.h"
+#include "data/quantile_index.h"
+#include "data/value_bitmap_index.h"
+#include "data/sorted_value_index.h"
+#include "data/run_detector.h"
+#include "data/degree_day_index.h"
+#include "data/historical_sampler.h"
+#include "data/quantile_sketch.h"
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 /**
@@ -22,6 +43,9 @@
 class WeatherArchive {
 public:
 
+    /** @brief Number of ensemble members sampled by a thread at a time by sampleBands */
+    static constexpr std::size_t MembersPerGroup = 16;
+
     /**
      * @brief Add a new weather data point into the archive
      *
@@ -29,11 +53,46 @@ public:
      * is replaced.
      * If the data does not have a timestamp it cannot be added to the archive, and 
      * this method does nothing.
+     * Adding data later in time than all archive data is O(1), adding it anywhere
+     * else is O(n). Use addBatch to add many data points that are not in time order.
      *
      * @param[in] data Weather data to add
      */
     void addData(const WeatherData& data);
 
+    /**
+     * @brief Add a batch of weather data points into the archive
+     *
+     * Equivalent to calling addData for each element in order, but the batch is
+     * merged in a single pass. If the batch is sorted by timestamp and begins after
+     * the data already in the archive (the common case when loading a file), it is
+     * appended in O(n). Otherwise the batch is sorted once and merged.
+     *
+     * If the batch contains multiple data points with the same timestamp, the one
+     * appearing last is kept. Data within the batch replaces archive data with the
+     * same timestamp. Data that does not have a timestamp is ignored.
+     *
+     * @param[in] data Weather data to add, which is moved into the archive
+     */
+    void addBatch(std::vector<WeatherData>&& data);
+
+    /**
+     * @brief Add a range of weather data points into the archive
+     *
+     * See addBatch(std::vector<WeatherData>&&). Pass move iterators to move the
+     * data into the archive instead of copying it.
+     *
+     * @param[in] first Iterator to the first data point to add
+     * @param[in] last Iterator past the last data point to add
+     */
+    template <typename InputIt>
+    void addBatch(InputIt first, InputIt last) {
+        addBatch(std::vector<WeatherData>(first, last));
+    }
+
+    /** @return The number of data points stored in the archive */
+    std::size_t size() const;
+
     /**
      * @brief Retrieve a single data point that matches the input time
      * @param[in] time Timestamp of the data point
@@ -53,13 +112,405 @@ public:
             const WeatherData::data_time begin_sec,
             const WeatherData::data_time end_sec) const;
 
+    /**
+     * @brief Retrieve the data point with the largest measurement of a variable
+     * within a time range. Data missing the variable is skipped.
+     *
+     * Answered in O(1) using an index that is built the first time it is needed
+     * after the archive changes.
+     *
+     * @param[in] variable The variable to compare
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @return The data point with the largest measurement (the earliest one if tied),
+     * or the optional will not be set if no data within the range has the variable
+     */
+    std::optional<WeatherData> retrieveMax(
+            const WeatherData::Variable variable,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Retrieve the data point with the smallest measurement of a variable
+     * within a time range. See retrieveMax.
+     */
+    std::optional<WeatherData> retrieveMin(
+            const WeatherData::Variable variable,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Count the data points within a time range whose measurement of a variable
+     * compares to a threshold (ex. tmax > 35). Data missing the variable never matches.
+     *
+     * Answered from a bitmap index of the variable (see ValueBitmapIndex), which is built
+     * the first time it is needed after the archive changes.
+     *
+     * @param[in] variable The variable
+     * @param[in] comparison How measurements are compared to the threshold
+     * @param[in] threshold The threshold
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @return The number of matching data points
+     */
+    std::size_t countWhere(
+            const WeatherData::Variable variable,
+            const ValueBitmapIndex::Comparison comparison,
+            const float threshold,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Retrieve the data points within a time range whose measurement of a variable
+     * compares to a threshold. See countWhere.
+     * @return The matching data points, in time order
+     */
+    std::vector<WeatherData> retrieveWhere(
+            const WeatherData::Variable variable,
+            const ValueBitmapIndex::Comparison comparison,
+            const float threshold,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Find runs of consecutive days within a time range whose measurement of a
+     * variable compares to a threshold (ex. heat waves of tmax > 35 for at least 3 days).
+     * A missing day, or a day missing the variable, ends a run. See RunDetector.
+     *
+     * @param[in] variable The variable of the condition
+     * @param[in] comparison How measurements are compared to the threshold
+     * @param[in] threshold The threshold
+     * @param[in] min_days The minimum number of days of a run
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] visitor Function called in time order with the first, last and peak data
+     * point and the number of days of each run
+     * @return The number of runs found
+     */
+    std::size_t retrieveRuns(
+            const WeatherData::Variable variable,
+            const ValueBitmapIndex::Comparison comparison,
+            const float threshold,
+            const std::size_t min_days,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const std::function<void(const WeatherData& first, const WeatherData& last,
+                const WeatherData& peak, std::size_t length)>& visitor) const;
+
+    /**
+     * @brief Find a percentile of the measurements of a variable within a time range.
+     * Data missing the variable is skipped.
+     *
+     * Short ranges are answered exactly. Long ranges are estimated by merging sketches
+     * of the months they cover (rank error below 1%), see QuantileIndex. The index is
+     * built the first time it is needed after the archive changes.
+     *
+     * @param[in] variable The variable
+     * @param[in] percentile The percentile, from 0 (minimum) to 100 (maximum)
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @return The percentile (nearest rank), or the optional will not be set if no data
+     * within the range has the variable
+     */
+    std::optional<float> retrievePercentile(
+            const WeatherData::Variable variable,
+            const double percentile,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Total the heating and cooling degree days within a time range
+     *
+     * The temperature of a day is its mean temperature, or the average of its maximum
+     * and minimum temperature if the mean is missing. The totals of each month are
+     * accumulated the first time a base temperature is used after the archive changes,
+     * so only the partial months at the ends of the range are visited. The temperatures
+     * are shared by every base, and the monthly totals of at most 64 bases are cached.
+     * See DegreeDayIndex.
+     *
+     * @param[in] base The base temperature, in Celcius
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @return The degree day totals of the range
+     */
+    DegreeDayIndex::DegreeDays retrieveDegreeDays(
+            const float base,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Create weather data for every day of a time range by sampling historical data:
+     * the data of each day is taken from the same calendar day of a year chosen at random
+     * from a range of years. Days without data in any year of the range are omitted.
+     *
+     * The draw of each day is a pure function of the seed and the day, so the result is
+     * reproducible, and does not depend on thread_count. See HistoricalSampler.
+     *
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] first_year The first year to sample from
+     * @param[in] last_year The last year to sample from (inclusive)
+     * @param[in] seed The seed of the random draws
+     * @param[in] thread_count Number of threads to use
+     * @param[in] member The member of an ensemble of samples. Members with the same seed are
+     * drawn independently of each other
+     * @param[in] block_length Number of consecutive days sampled from the same year (a block
+     * bootstrap), which keeps the persistence of the weather within each block. 1 samples
+     * every day independently
+     * @param[in] year_weights Relative weight of each year of the range, first_year first
+     * (see HistoricalSampler). If empty, every year has the same weight
+     * @return The sampled data, with the time of each data point set to its day of the range
+     */
+    std::vector<WeatherData> sampleHistory(
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const int first_year,
+            const int last_year,
+            const std::uint64_t seed,
+            const std::size_t thread_count = 1,
+            const std::uint64_t member = 0,
+            const std::size_t block_length = 1,
+            const std::vector<double>& year_weights = {}) const;
+
+    /**
+     * @brief Estimate the distribution of a variable on every day of a time range over an
+     * ensemble of historical samples (see sampleHistory), without keeping the members.
+     *
+     * The values of each day are added to a QuantileSketch as the members are sampled, so
+     * memory depends on the number of days, not members. Members are sampled on multiple
+     * threads in fixed groups of MembersPerGroup, whose sketches are merged in member order,
+     * so the result does not depend on thread_count.
+     *
+     * @param[in] variable The variable
+     * @param[in] member_count The number of members of the ensemble, 0 to member_count - 1
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] first_year The first year to sample from
+     * @param[in] last_year The last year to sample from (inclusive)
+     * @param[in] seed The seed of the random draws
+     * @param[in] thread_count Number of threads to use
+     * @param[in] block_length Number of consecutive days sampled from the same year
+     * @param[in] year_weights Relative weight of each year of the range, first_year first
+     * @return The sketch of each day of the range, the first day first. The sketch of a day
+     * without data in any year of the range is empty
+     */
+    std::vector<QuantileSketch> sampleBands(
+            const WeatherData::Variable variable,
+            const std::size_t member_count,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const int first_year,
+            const int last_year,
+            const std::uint64_t seed,
+            const std::size_t thread_count = 1,
+            const std::size_t block_length = 1,
+            const std::vector<double>& year_weights = {}) const;
+
+    /**
+     * @brief Get the sampler of a range of years, which finds the data of every calendar
+     * day of the range the first time it is needed after the archive changes
+     * @param[in] first_year The first year to sample from
+     * @param[in] last_year The last year to sample from (inclusive)
+     * @param[in] year_weights Relative weight of each year of the range, first_year first.
+     * If empty, every year has the same weight
+     * @return The sampler
+     */
+    std::shared_ptr<const HistoricalSampler> sampler(
+            const int first_year,
+            const int last_year,
+            const std::vector<double>& year_weights = {}) const;
+
+    /**
+     * @brief Summarize (count, sum, min, max) the measurements of a variable within a
+     * time range. Data missing the variable is skipped.
+     *
+     * Long ranges are split into blocks that are reduced on multiple threads, and
+     * combined in a fixed order, so the result does not depend on thread_count.
+     * See RangeReducer.
+     *
+     * @param[in] variable The variable to summarize
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] thread_count Number of threads to use
+     * @return Summary of the variable's measurements within the range
+     */
+    VariableSummary summarizeRange(
+            const WeatherData::Variable variable,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const std::size_t thread_count = 1) const;
+
+    /**
+     * @brief Compute the moving count, mean, minimum and maximum of a variable for every
+     * data point within a time range, in a single linear pass. See RollingWindow.
+     *
+     * @param[in] variable The variable to aggregate
+     * @param[in] window_sec Length of the window in seconds, ending at each data point
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] visitor Function called in time order with the time of each data point and
+     * the summary of the variable within its window
+     * @return The number of data points visited
+     */
+    std::size_t retrieveRolling(
+            const WeatherData::Variable variable,
+            const WeatherData::data_time window_sec,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const std::function<void(WeatherData::data_time, const VariableSummary&)>& visitor) const;
+
+    /**
+     * @brief Retrieve the data points with the most extreme measurements of a variable
+     * within a time range (ex. the 10 hottest days). Data missing the variable is skipped.
+     *
+     * Answered from a value sorted index of the variable (see SortedValueIndex), which is
+     * built the first time it is needed after the archive changes.
+     *
+     * @param[in] variable The variable to compare
+     * @param[in] k The number of data points to retrieve
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] extremum Max for the largest measurements, Min for the smallest
+     * @return Up to k data points, most extreme first (the earliest first if tied)
+     */
+    std::vector<WeatherData> retrieveTop(
+            const WeatherData::Variable variable,
+            const std::size_t k,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const RangeExtremumIndex::Extremum extremum = RangeExtremumIndex::Extremum::Max) const;
+
+    /**
+     * @brief Get a column oriented copy of the archive data, which is built the first
+     * time it is needed after the archive changes
+     * @return The archive data as columns, in the same order as the archive
+     */
+    std::shared_ptr<const WeatherColumns> columns() const;
+
+    /**
+     * @brief Get the calendar rollup of the archive data. The rollup is maintained as
+     * data is added, so reading it never visits the daily data.
+     * @return Monthly and yearly summaries of the archive data
+     */
+    const WeatherRollup& rollup() const;
+
+    /**
+     * @brief Get the climatological normals (a summary of every calendar day) over a
+     * range of years, for example the mean tmax of every March 14 from 1991 to 2020.
+     *
+     * The normals of each year range are built in a single pass the first time they are
+     * needed after the archive changes, and cached until it changes again.
+     *
+     * @param[in] first_year The first year of the range
+     * @param[in] last_year The last year of the range (inclusive)
+     * @return The normals of the year range
+     */
+    std::shared_ptr<const ClimatologyNormals> normals(
+            const int first_year,
+            const int last_year) const;
+
 private:
 
-    /**@brief Store weather data in a map, using the time as the key.
+    /**
+     * @brief Indexes derived from mWeatherData, which are built when they are first
+     * needed and cleared when mWeatherData changes.
+     *
+     * Const methods of the archive may build indexes, so each index is only accessed
+     * with std::atomic_load and std::atomic_store. This makes concurrent readers of an
+     * archive that is not being modified safe (see ConcurrentWeatherArchive).
+     * Copying an archive does not copy its indexes.
      *
-     * An ordered map is used so that ranges of data can be easily created
+     * The indexes cached per query parameter hold at most KeyedLimit entries each, so
+     * a long lived archive queried with arbitrary parameters (ex. degree day bases) does
+     * not grow without bound. A full map is cleared before the next entry is added;
+     * indexes in use are kept alive by their callers.
      */
-    std::map<WeatherData::data_time, WeatherData> mWeatherMap;
+    struct IndexCache {
+        /** @brief Maximum number of indexes of each map cached per query parameter */
+        static constexpr std::size_t KeyedLimit = 64;
+
+        IndexCache() = default;
+        IndexCache(const IndexCache&) {}
+        IndexCache& operator= (const IndexCache&) { clear(); return *this; }
+
+        /** @brief Clear all indexes. Does nothing if no index was built since the last clear */
+        void clear();
+
+        /**@brief An index may have been built since the cache was last cleared */
+        std::atomic<bool> built {false};
+
+        /**@brief The archive data as columns */
+        std::shared_ptr<const WeatherColumns> columns;
+
+        /**@brief Min and max index of each variable, at 2 * variable (+ 1 for max) */
+        std::array<std::shared_ptr<const RangeExtremumIndex>,
+            2 * WeatherData::VariableCount> extremums;
+
+        /**@brief Quantile index of each variable, indexed by WeatherData::Variable */
+        std::array<std::shared_ptr<const QuantileIndex>, WeatherData::VariableCount> quantiles;
+
+        /**@brief Bitmap index of each variable, indexed by WeatherData::Variable */
+        std::array<std::shared_ptr<const ValueBitmapIndex>, WeatherData::VariableCount> bitmaps;
+
+        /**@brief Value sorted index of each variable, at 2 * variable (+ 1 for max) */
+        std::array<std::shared_ptr<const SortedValueIndex>,
+            2 * WeatherData::VariableCount> sortedValues;
+
+        /**@brief Guards the indexes cached per query parameter, since any number may be cached */
+        std::mutex keyedMutex;
+
+        /**@brief Climatological normals, keyed by (first year, last year) */
+        std::map<std::pair<int, int>, std::shared_ptr<const ClimatologyNormals>> normals;
+
+        /**@brief Temperatures of the degree day indexes, shared by every base */
+        std::shared_ptr<const DegreeDayIndex::Temperatures> temperatures;
+
+        /**@brief Degree day indexes (monthly prefix sums), keyed by base temperature */
+        std::map<float, std::shared_ptr<const DegreeDayIndex>> degreeDays;
+
+        /**@brief Historical samplers, keyed by (first year, last year, year weights) */
+        std::map<std::tuple<int, int, std::vector<double>>,
+            std::shared_ptr<const HistoricalSampler>> samplers;
+    };
+
+    /**
+     * @brief Retrieve the data point with the extremum of a variable within a time range
+     * @param[in] variable The variable to compare
+     * @param[in] extremum Which extremum to find
+     * @param[in] begin_sec The beginning of the time range
+     * @param[in] end_sec The end of the time range
+     * @return The data point, if any data within the range has the variable
+     */
+    std::optional<WeatherData> retrieveExtremum(
+            const WeatherData::Variable variable,
+            const RangeExtremumIndex::Extremum extremum,
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Get the bitmap index of a variable, building it if it is not cached
+     * @param[in] variable The variable
+     * @return The index
+     */
+    std::shared_ptr<const ValueBitmapIndex> bitmapIndex(const WeatherData::Variable variable) const;
+
+    /**
+     * @brief Find the first stored data point with a timestamp at or after time
+     * @param[in] time Timestamp to search for
+     * @return Iterator into mWeatherData
+     */
+    std::vector<WeatherData>::const_iterator lowerBound(const WeatherData::data_time time) const;
+
+    /**@brief Store weather data sorted by time, with at most one data point per time.
+     *
+     * Every stored data point has its time set. A sorted vector is used so that
+     * ranges of data are contiguous, and appending in time order is cheap.
+     */
+    std::vector<WeatherData> mWeatherData;
+
+    WeatherRollup mRollup; /**<@brief Calendar summaries of mWeatherData */
+
+    mutable IndexCache mIndexCache; /**<@brief Indexes derived from mWeatherData */
 
 };
 #endif // WEATHER_ARCHIVE_H
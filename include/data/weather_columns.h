@@ -0,0 +1,71 @@
+/**
+ * @file weather_columns.h
+ * @date 10/16/2026
+ *
+ * @brief WeatherColumns class declaration
+ */
+
+#ifndef WEATHER_COLUMNS_H
+#define WEATHER_COLUMNS_H
+
+#include "data/weather_data.h"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+/**
+ * @class WeatherColumns weather_columns.h "data/weather_columns.h"
+ * @brief A column oriented copy of time ordered weather data.
+ *
+ * Each variable is stored in its own contiguous array, parallel to the array of
+ * timestamps, so aggregate queries over a single variable read only that variable.
+ * Missing measurements are stored as NaN.
+ */
+class WeatherColumns {
+public:
+
+    /**
+     * @brief Constructor
+     * @param[in] data Weather data sorted by time, with every timestamp set
+     */
+    explicit WeatherColumns(const std::vector<WeatherData>& data);
+
+    /** @return The number of data points */
+    std::size_t size() const;
+
+    /** @return Timestamps of the data points, in increasing order */
+    const std::vector<WeatherData::data_time>& times() const;
+
+    /**
+     * @brief Get the measurements of a variable
+     * @param[in] variable The variable
+     * @return Measurements parallel to times(), NaN where the measurement is missing
+     */
+    const std::vector<float>& values(const WeatherData::Variable variable) const;
+
+    /**
+     * @brief Find the data points within a time range
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @return Indices [first, last) of the data points within the range
+     */
+    std::pair<std::size_t, std::size_t> range(
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const;
+
+    /**
+     * @brief Find where each calendar month of the data begins
+     * @return Position of the first data point of each month that has data, in
+     * increasing order, followed by size()
+     */
+    std::vector<std::size_t> monthStarts() const;
+
+private:
+
+    std::vector<WeatherData::data_time> mTimes; /**<@brief Timestamps */
+    /**@brief Measurements of each variable, indexed by WeatherData::Variable */
+    std::array<std::vector<float>, WeatherData::VariableCount> mValues;
+
+};
+#endif // WEATHER_COLUMNS_H
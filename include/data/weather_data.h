@@ -9,6 +9,7 @@
 #define WEATHER_DATA_H
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 #include <ostream>
 
@@ -22,6 +23,30 @@ public:
     /** @brief Declare the type for a Unix seconds timestamp */
     using data_time = std::chrono::seconds::rep;
 
+    /** @brief Number of seconds in a day */
+    static constexpr data_time DaySeconds = 86400;
+
+    /**
+     * @brief Get the day number (days since 1970-01-01) of a timestamp
+     * @param[in] time Unix timestamp in seconds
+     * @return The day number, rounded towards negative infinity so times before 1970
+     * belong to the right day
+     */
+    static constexpr data_time dayNumber(const data_time time) {
+        return (time >= 0) ? time / DaySeconds : (time - DaySeconds + 1) / DaySeconds;
+    }
+
+    /** @brief The measured variables of a weather data reading */
+    enum class Variable {
+        MaxTemp, /**<@brief maxTemp */
+        MinTemp, /**<@brief minTemp */
+        MeanTemp, /**<@brief meanTemp */
+        GasPpt /**<@brief gas_ppt */
+    };
+
+    /** @brief The number of measured variables */
+    static constexpr std::size_t VariableCount = 4;
+
     /** @brief The data's (GMT/UTC) Unix timestamp in seconds, if available */
     std::optional<data_time> time; 
     
@@ -37,6 +62,16 @@ public:
     /** @brief The concentration of a gas in the atmosphere, in parts per trillion (ppt), if available */
     std::optional<float> gas_ppt;
 
+    /**
+     * @brief Get the measurement of a variable
+     * @param[in] variable The variable
+     * @return The measurement, which may or may not be set
+     */
+    const std::optional<float>& value(const Variable variable) const;
+
+    /** @copydoc value(const Variable) const */
+    std::optional<float>& value(const Variable variable);
+
     // Overload comparison operators b/c they are not default created (compiler warning)
     bool operator!= (const WeatherData& other) const;
     bool operator== (const WeatherData& other) const;
@@ -0,0 +1,90 @@
+/**
+ * @file weather_rollup.h
+ * @date 10/16/2026
+ *
+ * @brief WeatherRollup class declaration
+ */
+
+#ifndef WEATHER_ROLLUP_H
+#define WEATHER_ROLLUP_H
+
+#include "data/weather_data.h"
+#include "data/weather_summary.h"
+
+#include <array>
+#include <map>
+#include <vector>
+
+/**
+ * @class WeatherRollup weather_rollup.h "data/weather_rollup.h"
+ * @brief A calendar pyramid of summaries of daily weather data: each year holds a
+ * WeatherSummary of the whole year and of each of its months.
+ *
+ * Adding a data point updates its month and year in O(log years). Replacing a data
+ * point recomputes its month from the daily data (a minimum or maximum cannot be
+ * subtracted). Monthly, seasonal and yearly tables are then read from the summaries
+ * without visiting the daily data.
+ */
+class WeatherRollup {
+public:
+
+    /** @brief The calendar period of a table row */
+    enum class Period {
+        Month, /**<@brief Calendar months */
+        Season, /**<@brief Meteorological seasons: DJF, MAM, JJA, SON */
+        Year /**<@brief Calendar years */
+    };
+
+    /** @brief A row of a rollup table */
+    struct Row {
+        int year; /**<@brief Year of the period. A DJF season belongs to the year of its January */
+        /**@brief Month (1-12) or season (0 = DJF, 1 = MAM, 2 = JJA, 3 = SON) of the period,
+         * 0 for a year */
+        int index;
+        WeatherSummary summary; /**<@brief Summary of the data within the period */
+    };
+
+    /** @brief Constructor of an empty rollup */
+    WeatherRollup() = default;
+
+    /**
+     * @brief Construct the rollup of a collection of data
+     * @param[in] data Weather data, with every timestamp set and no duplicate timestamps
+     */
+    explicit WeatherRollup(const std::vector<WeatherData>& data);
+
+    /**
+     * @brief Add a data point whose timestamp is not already within the rollup
+     * @param[in] data The data point, which must have its timestamp set
+     */
+    void add(const WeatherData& data);
+
+    /**
+     * @brief Recompute the month containing a timestamp, after a data point within it
+     * was replaced
+     * @param[in] time A timestamp within the month
+     * @param[in] sorted_data All weather data, sorted by time
+     */
+    void rebuildMonth(const WeatherData::data_time time,
+            const std::vector<WeatherData>& sorted_data);
+
+    /**
+     * @brief Create a table of the summaries of each period, in chronological order.
+     * Periods without any data are omitted.
+     * @param[in] period The period of each row
+     * @return The table rows
+     */
+    std::vector<Row> table(const Period period) const;
+
+private:
+
+    /** @brief The summaries of a single year */
+    struct YearNode {
+        WeatherSummary year; /**<@brief Summary of the whole year */
+        std::array<WeatherSummary, 12> months; /**<@brief Summary of each month, January first */
+    };
+
+    std::map<int, YearNode> mYears; /**<@brief Summaries of each year, keyed by year */
+
+};
+#endif // WEATHER_ROLLUP_H
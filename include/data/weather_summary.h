@@ -0,0 +1,78 @@
+/**
+ * @file weather_summary.h
+ * @date 10/16/2026
+ *
+ * @brief VariableSummary and WeatherSummary struct declarations
+ */
+
+#ifndef WEATHER_SUMMARY_H
+#define WEATHER_SUMMARY_H
+
+#include "data/weather_data.h"
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @struct VariableSummary weather_summary.h "data/weather_summary.h"
+ * @brief Count, sum, minimum and maximum of the measurements of a variable.
+ * Summaries can be merged, so summaries of parts of a range combine into the
+ * summary of the whole range.
+ */
+struct VariableSummary {
+
+    std::size_t count {0}; /**<@brief Number of measurements */
+    double sum {0}; /**<@brief Sum of the measurements */
+    float min {0}; /**<@brief Smallest measurement, only valid if count > 0 */
+    float max {0}; /**<@brief Largest measurement, only valid if count > 0 */
+
+    /**
+     * @brief Add a measurement to the summary
+     * @param[in] value The measurement
+     */
+    void add(const float value);
+
+    /**
+     * @brief Add the measurements of another summary to this summary
+     * @param[in] other The other summary
+     */
+    void merge(const VariableSummary& other);
+
+    /** @return The mean of the measurements, or NaN if there are none */
+    double mean() const;
+
+};
+
+/**
+ * @struct WeatherSummary weather_summary.h "data/weather_summary.h"
+ * @brief A VariableSummary for each variable of a collection of weather data
+ */
+struct WeatherSummary {
+
+    std::size_t count {0}; /**<@brief Number of data points */
+
+    /**@brief Summary of each variable, indexed by WeatherData::Variable */
+    std::array<VariableSummary, WeatherData::VariableCount> variables;
+
+    /**
+     * @brief Add the measurements of a data point to the summary. Missing measurements
+     * are skipped.
+     * @param[in] data The data point
+     */
+    void add(const WeatherData& data);
+
+    /**
+     * @brief Add the measurements of another summary to this summary
+     * @param[in] other The other summary
+     */
+    void merge(const WeatherSummary& other);
+
+    /**
+     * @brief Get the summary of a variable
+     * @param[in] variable The variable
+     * @return The variable's summary
+     */
+    const VariableSummary& variable(const WeatherData::Variable variable) const;
+
+};
+#endif // WEATHER_SUMMARY_H
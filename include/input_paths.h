@@ -0,0 +1,55 @@
+/**
+ * @file input_paths.h
+ * @date 10/17/2026
+ *
+ * @brief inputpaths namespace declaration
+ */
+
+#ifndef INPUT_PATHS_H
+#define INPUT_PATHS_H
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace inputpaths
+ * @brief Functions to resolve the paths of weather data files passed on the command line
+ */
+namespace inputpaths {
+
+    /**
+     * @brief This class defines the exception thrown when an input path cannot be
+     * resolved to any files
+     */
+    class InputPathError : public std::runtime_error {
+    public:
+        /** @brief Constructor that sets error message
+         *  @param[in] error Error message */
+        explicit InputPathError(const std::string& error) : std::runtime_error(error) {}
+    };
+
+    /**
+     * @brief Check if a path contains glob(7) wildcard characters (*, ?, or [)
+     * @param[in] path The path
+     * @return True if the path is a glob pattern
+     */
+    bool isGlobPattern(const std::string& path);
+
+    /**
+     * @brief Expand paths to weather data into a list of files
+     *
+     * - A directory is replaced by the .json files it contains, in filename order
+     * - A glob pattern that is not an existing path is replaced by the paths matching
+     *   the pattern, in sorted order
+     * - Any other path is kept as is
+     *
+     * @param[in] paths Files, directories, or glob patterns
+     * @throws InputPathError if a directory cannot be read or contains no .json files, or
+     * a pattern matches no files
+     * @return The expanded list of files, in the order of paths
+     */
+    std::vector<std::string> expandInputPaths(const std::vector<std::string>& paths) noexcept(false);
+
+} // inputpaths
+#endif // INPUT_PATHS_H
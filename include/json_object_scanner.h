@@ -0,0 +1,75 @@
+/**
+ * @file json_object_scanner.h
+ * @date 10/16/2026
+ *
+ * @brief jsonparse::JsonObjectScanner class declaration
+ */
+
+#ifndef JSON_OBJECT_SCANNER_H
+#define JSON_OBJECT_SCANNER_H
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace jsonparse {
+
+    /**
+     * @class JsonObjectScanner json_object_scanner.h "json_object_scanner.h"
+     * @brief Split a stream of JSON weather data into the text of its individual objects
+     *
+     * The stream must contain either a JSON Array of objects, or a single object.
+     * Only the structure of the JSON (brackets, braces and strings) is scanned, so
+     * the objects are found without parsing their contents, and the stream is read
+     * in fixed size chunks so memory use is independent of the stream size.
+     * The object text can be parsed with jsonFromString.
+     */
+    class JsonObjectScanner {
+    public:
+
+        /**
+         * @brief Constructor
+         * @param[in] input Stream to scan, which must outlive the scanner
+         */
+        explicit JsonObjectScanner(std::istream& input);
+
+        /**
+         * @brief Find the next top level object within the stream
+         * @param[out] object_text The text of the object, from '{' to '}'
+         * @param[out] offset Byte offset of the object's '{' within the stream
+         * @throws IncorrectJson if the stream is not an array of objects or an object
+         * @return True if an object was found, false if the end of the stream was reached
+         */
+        bool next(std::string& object_text, std::uint64_t& offset) noexcept(false);
+
+        /**
+         * @brief Extract the "date" value of an object without parsing the whole object
+         * @param[in] object_text The text of a single JSON object
+         * @return The Unix time of the date, if the object has a valid date
+         */
+        static std::optional<std::int64_t> findDate(const std::string& object_text);
+
+    private:
+
+        /**
+         * @brief Get the next character from the stream
+         * @param[out] c The character
+         * @return False if the end of the stream was reached
+         */
+        bool nextChar(char& c);
+
+        std::istream& mInput; /**<@brief Stream being scanned */
+        std::vector<char> mBuffer; /**<@brief Chunk of the stream being scanned */
+        std::size_t mBufferPos {0}; /**<@brief Position of the next character in mBuffer */
+        std::size_t mBufferSize {0}; /**<@brief Number of valid characters in mBuffer */
+        std::uint64_t mStreamPos {0}; /**<@brief Byte offset of the next character */
+        bool mRootIsArray {false}; /**<@brief The stream contains an array of objects */
+        bool mStarted {false}; /**<@brief The root value has been found */
+        bool mFinished {false}; /**<@brief The root value has been fully scanned */
+
+    };
+
+} // jsonparse
+#endif // JSON_OBJECT_SCANNER_H
@@ -8,11 +8,15 @@
 #ifndef JSON_PARSE_H
 #define JSON_PARSE_H
 
+#include "data/weather_columns.h"
 #include "data/weather_data.h"
+#include "data/weather_summary.h"
 
 #include <jsoncpp/json/value.h>
+#include <ostream>
 #include <string>
 #include <regex>
+#include <vector>
 
 /**
  * @namespace jsonparse
@@ -36,6 +40,35 @@ namespace jsonparse {
     const std::string TMEAN_KEY {"tmean"}; /**<@brief String for tmean key within the JSON data*/
     const std::string PPT_KEY {"ppt"}; /**<@brief String for ppt key within the JSON data*/
 
+    const std::string COUNT_KEY {"count"}; /**<@brief String for count key within summary JSON data*/
+    const std::string MEAN_KEY {"mean"}; /**<@brief String for mean key within summary JSON data*/
+    const std::string MIN_KEY {"min"}; /**<@brief String for min key within summary JSON data*/
+    const std::string MAX_KEY {"max"}; /**<@brief String for max key within summary JSON data*/
+    const std::string PERIOD_KEY {"period"}; /**<@brief String for period key within rollup JSON data*/
+    const std::string DAY_KEY {"day"}; /**<@brief String for day key within normals JSON data*/
+    const std::string START_KEY {"start"}; /**<@brief String for start key within runs JSON data*/
+    const std::string END_KEY {"end"}; /**<@brief String for end key within runs JSON data*/
+    const std::string LENGTH_KEY {"length"}; /**<@brief String for length key within runs JSON data*/
+    const std::string PEAK_KEY {"peak"}; /**<@brief String for peak key within runs JSON data*/
+    const std::string HEATING_KEY {"heating"}; /**<@brief String for heating key within degree day JSON data*/
+    const std::string COOLING_KEY {"cooling"}; /**<@brief String for cooling key within degree day JSON data*/
+    const std::string MEMBER_KEY {"member"}; /**<@brief String for member key within ensemble JSON data*/
+    const std::string DATA_KEY {"data"}; /**<@brief String for data key within ensemble JSON data*/
+
+
+    /**
+     * @brief Get the WeatherData variable that a JSON key holds
+     * @param[in] key A JSON key (ex. "tmax")
+     * @return The variable, or the optional will not be set if the key is not a variable
+     */
+    std::optional<WeatherData::Variable> keyToVariable(const std::string& key);
+
+    /**
+     * @brief Get the JSON key of a WeatherData variable
+     * @param[in] variable The variable
+     * @return The JSON key (ex. "tmax")
+     */
+    const std::string& variableToKey(const WeatherData::Variable variable);
 
     /** @brief This struct defines the exception thrown to report an incorrect JSON argument */
     struct IncorrectJson : public std::exception
@@ -73,6 +106,92 @@ namespace jsonparse {
      */
     std::string jsonPretty(const Json::Value& schema);
 
+    /**
+     * @brief Create a string containing the JSON schema on a single line, without whitespace.
+     * Numbers are formatted the same as jsonPretty.
+     * @param[in] schema JSON data to format
+     * @return String containing JSON data.
+     */
+    std::string jsonCompact(const Json::Value& schema);
+
+    /** @brief Size of a buffer that can hold any number written by formatNumber */
+    constexpr std::size_t NumberBufferSize = 32;
+
+    /**
+     * @brief Write a number the same as jsonPretty does (6 significant digits, ".0" appended
+     * to whole numbers), using std::to_chars instead of printf and without allocating.
+     * @param[in] value The number
+     * @param[out] buffer Buffer of at least NumberBufferSize characters. It is not null
+     * terminated
+     * @return The number of characters written
+     */
+    std::size_t formatNumber(const double value, char* buffer);
+
+    /**
+     * @class JsonArrayWriter json_parse.h "json_parse.h"
+     * @brief Write a JSON Array one element at a time, so large arrays do not need to
+     * be held in memory. The output is identical to jsonPretty of the whole array, or to
+     * jsonCompact of the whole array for a compact writer.
+     */
+    class JsonArrayWriter {
+    public:
+
+        /**
+         * @brief Constructor
+         * @param[in] out Stream to write to, which must outlive the writer
+         * @param[in] compact Write the array on a single line, without whitespace
+         */
+        explicit JsonArrayWriter(std::ostream& out, const bool compact = false);
+
+        /**
+         * @brief Write the next element of the array
+         * @param[in] element JSON data of the element
+         */
+        void write(const Json::Value& element);
+
+        /**
+         * @brief Write weather data as the next element of the array. The output is the
+         * same as writing createWeatherJson of the data, but is formatted directly
+         * (see formatDate and formatNumber) instead of through a Json::Value.
+         * @param[in] data The weather data
+         */
+        void write(const WeatherData& data);
+
+        /** @brief Finish the array. No elements may be written after closing it */
+        void close();
+
+    private:
+
+        std::ostream& mOut; /**<@brief Stream the array is written to */
+        const bool mCompact; /**<@brief The array is written without whitespace */
+        bool mEmpty {true}; /**<@brief No elements have been written yet */
+
+    };
+
+    /**
+     * @brief Write weather data as a single JSON Object of parallel arrays, one per key
+     * ("date", "ppt", "tmax", "tmean", "tmin"), on a single line without whitespace.
+     * Missing measurements are null. Each array is written straight from its column, with
+     * the same formatting as JsonArrayWriter.
+     * @param[in] out Stream to write to
+     * @param[in] columns Column storage of the weather data
+     * @param[in] first Position of the first data point to write
+     * @param[in] last Position after the last data point to write
+     */
+    void writeColumns(
+            std::ostream& out,
+            const WeatherColumns& columns,
+            const std::size_t first,
+            const std::size_t last);
+
+    /**
+     * @brief Write weather data as a single JSON Object of parallel arrays, the same as
+     * writeColumns of column storage. A missing date is null.
+     * @param[in] out Stream to write to
+     * @param[in] data The weather data, in the order it is written
+     */
+    void writeColumns(std::ostream& out, const std::vector<WeatherData>& data);
+
     /**
      * @brief Convert a YYYY-MM-DD date string to Unix (UTC) time
      * (Number of seconds since January 1st, 1970 UTC)
@@ -82,6 +201,19 @@ namespace jsonparse {
      */
     std::optional<std::chrono::seconds::rep> dateToUnix(const std::string& date_string);
 
+    /** @brief The length of a YYYY-MM-DD date string */
+    constexpr std::size_t DateLength = 10;
+
+    /**
+     * @brief Write the YYYY-MM-DD date of a UNIX (UTC) time into a buffer, without
+     * allocating. The date is calculated with integer arithmetic (civil from days).
+     * @param[in] unix_time_sec A Unix timestamp, in seconds
+     * @param[out] buffer Buffer of at least DateLength characters. It is not null terminated
+     * @return True if the date was written, false if its year is not within 0-9999 and
+     * cannot be written as YYYY
+     */
+    bool formatDate(const std::chrono::seconds::rep unix_time_sec, char* buffer);
+
     /**
      * @brief Convert a UNIX (UTC) time to a YYYY-MM-DD date string
      * @param[in] unix_time_sec A Unix timestamp, in seconds
@@ -108,6 +240,20 @@ namespace jsonparse {
      */
     WeatherData parseWeather(const Json::Value& schema) noexcept(false);
 
+    /**
+     * @brief Read and parse a file containing weather data
+     *
+     * The file may contain either a JSON Array of weather data Schemas, or a
+     * single weather data Schema (see parseWeather). The data is returned in
+     * the same order it appears within the file.
+     *
+     * @param[in] filename Path to the JSON file
+     * @throws IncorrectJson if the file cannot be read, is not valid JSON, or
+     * an element of the array is not a JSON object
+     * @return The weather data contained in the file
+     */
+    std::vector<WeatherData> parseWeatherFile(const std::string& filename) noexcept(false);
+
     /**
      * @brief Create a JSON Schema containing weather data
      * The JSON Schema can contain the following key/value pairs:
@@ -121,9 +267,35 @@ namespace jsonparse {
      * If weather_data has data that is not set, the corresponding key/value pair will
      * be ommitted from the returned JSON schema.
      *
-     * @return A JSON Schema containing weather data
+     * @return A JSON Schema containing weather data, an empty object if no data is set
      */
     Json::Value createWeatherJson(const WeatherData& weather_data);
 
+    /**
+     * @brief Create a JSON Schema containing a summary of a variable's measurements
+     * The JSON Schema contains the following key/value pairs:
+     * - "count": number of measurements
+     * - "mean", "min", "max": mean, minimum and maximum of the measurements, ommitted if
+     *   there are no measurements
+     *
+     * @param[in] summary The summary to form the JSON schema with
+     * @return A JSON Schema containing the summary
+     */
+    Json::Value createVariableSummaryJson(const VariableSummary& summary);
+
+    /**
+     * @brief Create a JSON Schema containing a summary of weather data
+     * The JSON Schema contains the following key/value pairs:
+     * - "count": number of data points
+     * - "tmax", "tmin", "tmean", "ppt": object containing the "count", "mean", "min",
+     *   and "max" of the variable's measurements
+     *
+     * Variables without any measurements are ommitted.
+     *
+     * @param[in] summary The summary to form the JSON schema with
+     * @return A JSON Schema containing the summary
+     */
+    Json::Value createSummaryJson(const WeatherSummary& summary);
+
 } // jsonparse
 #endif // JSON_PARSE_H
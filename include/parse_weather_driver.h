@@ -10,8 +10,14 @@
 
 #include "json_parse.h"
 #include "data/weather_archive.h"
+#include "data/weather_rollup.h"
 #include <CLI/CLI.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <regex>
 #include <string>
+#include <thread>
 #include <vector>
 
 /**
@@ -34,6 +40,27 @@ public:
      */
     static constexpr int YearRangeLength = 9;
 
+    /** @brief Formats of the weather data output, chosen by the --output option */
+    enum class OutputFormat {
+        Pretty, /**<@brief An indented JSON Array */
+        Compact, /**<@brief A JSON Array on a single line */
+        Columnar, /**<@brief A JSON Object with an array for each key */
+        Arrow /**<@brief A binary Apache Arrow IPC stream */
+    };
+
+    /** @brief Strings denoting the periods accepted by the --rollup option */
+    const std::map<std::string, WeatherRollup::Period> RollupPeriods{
+        {"month", WeatherRollup::Period::Month},
+        {"season", WeatherRollup::Period::Season},
+        {"year", WeatherRollup::Period::Year}};
+
+    /** @brief Strings denoting the formats accepted by the --output option */
+    const std::map<std::string, OutputFormat> OutputFormats{
+        {"pretty", OutputFormat::Pretty},
+        {"compact", OutputFormat::Compact},
+        {"columnar", OutputFormat::Columnar},
+        {"arrow", OutputFormat::Arrow}};
+
     /** 
      * @brief Strings denoting weather data variable names that are accepted
      * by the --mean option
@@ -74,13 +101,54 @@ private:
     bool checkDateRange(const std::string& range_string) const;
 
     /**
-     * @brief Read the json data file containing weather data passed by the
+     * @brief Expand the paths passed by the --file option into a list of files
+     * (see inputpaths::expandInputPaths), reporting errors to stderr
+     * @param[out] filenames The expanded list of files, in precedence order
+     * @return True if every input path resolved to at least one file, false otherwise
+     */
+    bool expandInputPaths(std::vector<std::string>& filenames) const;
+
+    /**
+     * @brief Read the json data files containing weather data passed by the
      * --file option, and store the data within member variable mArchive
      *
-     * If the data file cannot be read, mArchive will not be modified
+     * The files are parsed concurrently, then merged into mArchive in the
+     * order they were passed. If multiple files contain data for the same date,
+     * the data from the file passed last takes precedence.
+     *
+     * If any data file cannot be read, mArchive will not be modified
      * @return True if the data was read and parsed successfully, false otherwise
      */
-    bool readInputFile();
+    bool readInputFiles();
+
+    /**
+     * @brief Run the --date or --range option in lazy mode (--lazy option)
+     *
+     * Instead of loading the whole input file into mArchive, an offset index of the
+     * file is used to parse only the data the query needs. With the --index-file
+     * option the index is loaded from (or saved to) a sidecar file next to the input.
+     * @throws CLI::ValidationError if more than one input file is passed, or the
+     * query is not --date or --range
+     */
+    void runLazyOption() const noexcept(false);
+
+    /**
+     * @brief Run the --date, --range, or --mean option in streaming mode (--stream option)
+     *
+     * Each input file is scanned once using constant memory, and results are output
+     * as the data streams past, instead of loading the files into mArchive. If a file
+     * is known to be in date order (--sorted option, or its --index-file sidecar
+     * records that it is sorted) the scan stops once it passes the requested dates.
+     * @throws CLI::ValidationError if the query is not --date, --range, or --mean, or
+     * the --mean inputs are not valid
+     */
+    void runStreamOption() const noexcept(false);
+
+    /**
+     * @brief Print the result of the --date option
+     * @param[in] data Data for the requested date, if it is available
+     */
+    void printDateResult(const std::optional<WeatherData>& data) const;
 
     /**
      * @brief Run functionality for the --date option
@@ -95,7 +163,9 @@ private:
     void runRangeOption() const;
 
     /**
-     * @brief Print weather data as a JSON Array
+     * @brief Print weather data in the format of the --output option: a JSON Array
+     * (pretty or compact), a JSON Object of parallel arrays (columnar), or an Arrow IPC
+     * stream (arrow)
      * @param[in] data Weather data to print
      */
     void printWeatherData(const std::vector<WeatherData>& data) const;
@@ -111,11 +181,85 @@ private:
      */
     void runMeanOption() const noexcept(false);
 
+    /**
+     * @brief Check the inputs of an option that accepts a date range and one other argument
+     *
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - The argument, which the caller validates
+     *
+     * @param[in] option_name Name of the option, used in error messages (ex. "--where")
+     * @param[in] error_name Name of the CLI::ValidationError thrown (ex. "WhereOptionError")
+     * @param[out] range_string The date range input
+     * @param[out] argument The other input
+     * @throws CLI::ValidationError if there are not two inputs, or neither is a date range
+     */
+    void checkRangeAndArgument(
+            const std::string& option_name,
+            const std::string& error_name,
+            std::string& range_string,
+            std::string& argument) const noexcept(false);
+
+    /**
+     * @brief Check the inputs of an option that accepts a date range and a variable name
+     *
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A string denoting the variable: tmax, tmin, tmean, or ppt
+     *
+     * @param[in] option_name Name of the option, used in error messages (ex. "-m, --mean")
+     * @param[in] error_name Name of the CLI::ValidationError thrown (ex. "MeanOptionError")
+     * @param[out] range_string The date range input
+     * @param[out] variable_name The variable name input
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void checkRangeVariableInputs(
+            const std::string& option_name,
+            const std::string& error_name,
+            std::string& range_string,
+            std::string& variable_name) const noexcept(false);
+
+    /**
+     * @brief Check the inputs of an option that accepts a date range, a variable name,
+     * and a number
+     *
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A string denoting the variable: tmax, tmin, tmean, or ppt
+     * - A number matching number_regex
+     *
+     * @param[in] option_name Name of the option, used in error messages (ex. "--rolling")
+     * @param[in] error_name Name of the CLI::ValidationError thrown (ex. "RollingOptionError")
+     * @param[in] number_regex Regex that the number input must match
+     * @param[out] range_string The date range input
+     * @param[out] variable_name The variable name input
+     * @param[out] number_string The number input
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void checkRangeVariableNumberInputs(
+            const std::string& option_name,
+            const std::string& error_name,
+            const std::regex& number_regex,
+            std::string& range_string,
+            std::string& variable_name,
+            std::string& number_string) const noexcept(false);
+
+    /**
+     * @brief Print the result of the --mean option
+     * @param[in] mean The calculated mean, or NaN if it could not be calculated
+     * @param[in] range_string The date range of the mean
+     * @param[in] variable_name The variable of the mean
+     */
+    void printMean(
+            const double mean,
+            const std::string& range_string,
+            const std::string& variable_name) const;
+
     /**
      * @brief Calculate the mean for a given variable, over a given date range
      *
      * If a variable is missing for a given day within the range, it is ignored
-     * as part of the calculation
+     * as part of the calculation. The range is reduced on mThreadCount threads.
      * 
      * @param[in] range_string A date range string: YYYY-MM-DD|YYYY-MM-DD
      * @param[in] variable_name A string denoting the variable (ex. "tmax")
@@ -126,6 +270,152 @@ private:
             const std::string& range_string,
             const std::string& variable_name) const;
 
+    /**
+     * @brief Run the functionality of the --max or --min option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A string denoting the variable: tmax, tmin, tmean, or ppt
+     *
+     * Outputs the date and value of the largest (or smallest) measurement of the
+     * variable within the date range.
+     * @param[in] find_max True for the --max option, false for the --min option
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runExtremumOption(const bool find_max) const noexcept(false);
+
+    /**
+     * @brief Run the functionality of the --rollup option
+     *
+     * Outputs a JSON Array with the summary (count, mean, min and max of each variable)
+     * of every month, season, or year of the archive.
+     * Validity of the input has already be checked by the parser
+     */
+    void runRollupOption() const;
+
+    /**
+     * @brief Run the functionality of the --normals option
+     *
+     * Outputs a JSON Array with the summary (count, mean, min and max of each variable)
+     * of every calendar day, over the years of the year range passed to the option.
+     * Calendar days without any data are omitted.
+     * Validity of the input has already be checked by the parser
+     */
+    void runNormalsOption() const;
+
+    /**
+     * @brief Run the functionality of the --rolling option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A string denoting the variable: tmax, tmin, tmean, or ppt
+     * - The window length in days: a positive integer
+     *
+     * Streams a JSON Array with the moving count, mean, min and max of the variable
+     * for every date within the date range.
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runRollingOption() const noexcept(false);
+
+    /**
+     * @brief Run the functionality of the --percentile option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A string denoting the variable: tmax, tmin, tmean, or ppt
+     * - The percentile: a number from 0 to 100
+     *
+     * Outputs the percentile of the variable's measurements within the date range.
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runPercentileOption() const noexcept(false);
+
+    /**
+     * @brief Run the functionality of the --count-where or --where option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A condition: a variable (tmax, tmin, tmean, or ppt), a comparison
+     *   (<, <=, =, >=, or >), and a number. Ex: tmax>35
+     *
+     * Outputs the number of dates within the date range that meet the condition, or
+     * their data as a JSON Array.
+     * @param[in] count_only True for the --count-where option, false for the --where option
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runWhereOption(const bool count_only) const noexcept(false);
+
+    /**
+     * @brief Run the functionality of the --top option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A string denoting the variable: tmax, tmin, tmean, or ppt
+     * - The number of dates: a positive integer
+     *
+     * Outputs the data of the dates with the largest measurements of the variable within
+     * the date range as a JSON Array, largest first.
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runTopOption() const noexcept(false);
+
+    /**
+     * @brief Parse a condition: a variable (tmax, tmin, tmean, or ppt), a comparison
+     * (<, <=, =, >=, or >), and a number. Ex: tmax>35
+     * @param[in] condition The condition string
+     * @param[out] variable The variable of the condition
+     * @param[out] comparison The comparison of the condition
+     * @param[out] threshold The number of the condition
+     * @return True if the condition was parsed, false if it is not valid
+     */
+    bool parseCondition(
+            const std::string& condition,
+            WeatherData::Variable& variable,
+            ValueBitmapIndex::Comparison& comparison,
+            float& threshold) const;
+
+    /**
+     * @brief Run the functionality of the --runs option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - A condition, see parseCondition. Ex: tmax>35
+     * - The minimum number of days of a run: a positive integer
+     *
+     * Outputs a JSON Array with the start date, end date, number of days and peak of
+     * every run of consecutive days within the date range that meet the condition.
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runRunsOption() const noexcept(false);
+
+    /**
+     * @brief Run the functionality of the --degree-days option
+     *
+     * Checks the validity of the inputs passed to the option.
+     * Allowed inputs are (in any order):
+     * - A date range: YYYY-MM-DD|YYYY-MM-DD
+     * - The base temperature in Celcius: a number
+     *
+     * Outputs the heating and cooling degree day totals within the date range, and the
+     * number of days with a temperature.
+     * @throws CLI::ValidationError if inputs are not valid
+     */
+    void runDegreeDaysOption() const noexcept(false);
+
+    /**
+     * @brief Make a query option exclude all other query options, so that only one
+     * query is accepted at a time
+     * @param[in] option The query option
+     * @return The option
+     */
+    CLI::Option* addQueryOption(CLI::Option* option);
+
     /**
      * @brief Run the functionality for the --sample option
      *
@@ -133,6 +423,10 @@ private:
      * Allowed inputs are (in exact order):
      * - A date range: YYYY-MM-DD|YYYY-MM-DD
      * - A year range: YYYY|YYYY
+     *
+     * The draws are seeded by the --seed option, or by std::random_device if it was not
+     * passed. With the --ensemble option, the members are output by printEnsemble, or their
+     * percentile bands by printEnsembleBands with the --bands option.
      * @throws CLI::ValidationError if inputs are not valid
      */
     void runSampleHistoryOption() const noexcept(false);
@@ -159,18 +453,85 @@ private:
      * selected year. If there is no avaialable data within the year_range for a 
      * given date, it is ommitted from the returned data.
      *
+     * Years are weighted by year_weights, and consecutive dates are sampled from the same year
+     * in blocks of the --block-length option.
+     * The same seed and member always give the same data, for any number of threads.
+     *
      * Assumes the passed parameters are in the correct format, the validity of the
      * parameters is not checked
      *
      * @param[in] date_range A date range string: YYYY-MM-DD|YYYY-MM-DD
      * @param[in] year_range A year range string: YYYY|YYYY
+     * @param[in] seed The seed of the random draws
+     * @param[in] year_weights Relative weight of each year (see readYearWeights)
+     * @param[in] member The member of an ensemble of samples
+     * @param[in] thread_count Number of threads to use
      *
      * @return The historically sampled data. An empty vector denotes that there is no data 
      * available within the date_range for any year requested.
      */
     std::vector<WeatherData> sampleHistoricalData(
             const std::string& date_range,
-            const std::string& year_range) const;
+            const std::string& year_range,
+            const std::uint64_t seed,
+            const std::vector<double>& year_weights,
+            const std::uint64_t member = 0,
+            const std::size_t thread_count = 1) const;
+
+    /**
+     * @brief Output the percentile bands of a variable over an ensemble of historical
+     * samples, as a JSON Array with the "date", the "count" of members with data, and each
+     * percentile of the --bands option (ex. "p10") for every date of the date range.
+     *
+     * Members are not kept, see WeatherArchive::sampleBands.
+     *
+     * @param[in] date_range A date range string: YYYY-MM-DD|YYYY-MM-DD
+     * @param[in] year_range A year range string: YYYY|YYYY
+     * @param[in] seed The seed of the random draws
+     * @param[in] year_weights Relative weight of each year (see readYearWeights)
+     * @throws CLI::ValidationError if the inputs of the --bands option are not valid
+     */
+    void printEnsembleBands(
+            const std::string& date_range,
+            const std::string& year_range,
+            const std::uint64_t seed,
+            const std::vector<double>& year_weights) const noexcept(false);
+
+    /**
+     * @brief Get the weight of each year of a year range from the --year-weights option
+     *
+     * - linear: the first year has weight 1, the next 2, and so on
+     * - exp:H: the weight halves every H years before the last year, which has weight 1
+     * - A file path: each line of the file is a year and its weight, separated by whitespace.
+     *   Years that are not listed have weight 0.
+     *
+     * @param[in] year_range A year range string: YYYY|YYYY
+     * @throws CLI::ValidationError if the weight file cannot be read, or no year of the range
+     * has a positive weight
+     * @return The weight of each year, the first year first. Empty if the option was not
+     * passed, which weights every year the same
+     */
+    std::vector<double> readYearWeights(const std::string& year_range) const noexcept(false);
+
+    /**
+     * @brief Output an ensemble of historical samples (see sampleHistoricalData) as
+     * newline delimited JSON: one line per member, in member order, containing the
+     * "member" number and its sampled "data" array.
+     *
+     * Members are sampled and formatted on mThreadCount threads, and each line is
+     * written as soon as the lines before it are, so memory use does not depend on
+     * the number of members.
+     *
+     * @param[in] date_range A date range string: YYYY-MM-DD|YYYY-MM-DD
+     * @param[in] year_range A year range string: YYYY|YYYY
+     * @param[in] seed The seed of the random draws
+     * @param[in] year_weights Relative weight of each year (see readYearWeights)
+     */
+    void printEnsemble(
+            const std::string& date_range,
+            const std::string& year_range,
+            const std::uint64_t seed,
+            const std::vector<double>& year_weights) const;
 
     // Option pointers
     CLI::Option* mpFileOption {nullptr}; /**<@brief --file option */
@@ -178,13 +539,64 @@ private:
     CLI::Option* mpRangeOption {nullptr}; /**<@brief --range option */
     CLI::Option* mpMeanOption {nullptr}; /**<@brief --mean option */
     CLI::Option* mpSampleHistoryOption {nullptr}; /**<@brief --sample option */
+    CLI::Option* mpMaxOption {nullptr}; /**<@brief --max option */
+    CLI::Option* mpMinOption {nullptr}; /**<@brief --min option */
+    CLI::Option* mpRollupOption {nullptr}; /**<@brief --rollup option */
+    CLI::Option* mpNormalsOption {nullptr}; /**<@brief --normals option */
+    CLI::Option* mpRollingOption {nullptr}; /**<@brief --rolling option */
+    CLI::Option* mpThreadsOption {nullptr}; /**<@brief --threads option */
+    CLI::Option* mpPercentileOption {nullptr}; /**<@brief --percentile option */
+    CLI::Option* mpCountWhereOption {nullptr}; /**<@brief --count-where option */
+    CLI::Option* mpWhereOption {nullptr}; /**<@brief --where option */
+    CLI::Option* mpTopOption {nullptr}; /**<@brief --top option */
+    CLI::Option* mpRunsOption {nullptr}; /**<@brief --runs option */
+    CLI::Option* mpDegreeDaysOption {nullptr}; /**<@brief --degree-days option */
+    CLI::Option* mpLazyOption {nullptr}; /**<@brief --lazy option */
+    CLI::Option* mpIndexFileOption {nullptr}; /**<@brief --index-file option */
+    CLI::Option* mpStreamOption {nullptr}; /**<@brief --stream option */
+    CLI::Option* mpSortedOption {nullptr}; /**<@brief --sorted option */
+    CLI::Option* mpSeedOption {nullptr}; /**<@brief --seed option */
+    CLI::Option* mpEnsembleOption {nullptr}; /**<@brief --ensemble option */
+    CLI::Option* mpBlockLengthOption {nullptr}; /**<@brief --block-length option */
+    CLI::Option* mpYearWeightsOption {nullptr}; /**<@brief --year-weights option */
+    CLI::Option* mpBandsOption {nullptr}; /**<@brief --bands option */
+    CLI::Option* mpOutputOption {nullptr}; /**<@brief --output option */
 
-    std::string mInputFilename; /**<@brief Absolute file path for input JSON file*/
+    /**@brief Paths to input JSON files, directories, or glob patterns */
+    std::vector<std::string> mInputFilenames;
     /**@brief String passed to an option that accepts a single string input*/
     std::string mOptionSingleString; 
     /**@brief Strings passed to an option that accepts multiple string inputs*/
     std::vector<std::string> mOptionMultiString;
 
+    /**@brief Number of threads passed by the --threads option */
+    std::size_t mThreadCount {std::max(std::thread::hardware_concurrency(), 1u)};
+
+    /**@brief Seed passed by the --seed option, a random seed is used if it is not passed */
+    std::uint64_t mSeed {0};
+
+    /**@brief Number of ensemble members passed by the --ensemble option */
+    std::size_t mEnsembleSize {1};
+
+    /**@brief Number of consecutive days sampled from the same year, passed by the
+     * --block-length option */
+    std::size_t mBlockLength {1};
+
+    /**@brief Year weights passed by the --year-weights option: linear, exp:H, or a file path */
+    std::string mYearWeights;
+
+    /**@brief Variable and percentiles passed by the --bands option */
+    std::vector<std::string> mBandsStrings;
+
+    /**@brief Format of weather data output passed by the --output option, a key of OutputFormats */
+    std::string mOutputString {"pretty"};
+
+    /**@brief Format of weather data output, parsed from mOutputString when the script runs */
+    OutputFormat mOutputFormat {OutputFormat::Pretty};
+
+    /**@brief Options that query the data, only one of which may be passed */
+    std::vector<CLI::Option*> mQueryOptions;
+
     WeatherArchive mArchive; /**<@brief Store/retrieve weather data*/
 
 };
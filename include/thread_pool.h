@@ -0,0 +1,78 @@
+/**
+ * @file thread_pool.h
+ * @date 10/16/2026
+ *
+ * @brief ThreadPool class declaration
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class ThreadPool thread_pool.h "thread_pool.h"
+ * @brief A fixed size pool of worker threads that run submitted tasks
+ *
+ * Tasks are run in the order they are submitted. Destroying the pool waits
+ * for all submitted tasks to finish.
+ */
+class ThreadPool {
+public:
+
+    /**
+     * @brief Constructor that starts the worker threads
+     * @param[in] thread_count Number of worker threads. If 0, a single worker
+     * thread is created.
+     */
+    explicit ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency());
+
+    /** @brief Destructor that finishes all submitted tasks, then joins the worker threads */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+
+    /**
+     * @brief Submit a task to be run by one of the worker threads
+     * @param[in] task Callable object that takes no arguments
+     * @return A future that holds the task's result, or the exception it threw
+     */
+    template <typename Task>
+    std::future<std::invoke_result_t<Task>> submit(Task&& task) {
+        // std::function requires a copyable target, so share the packaged_task
+        auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<Task>()>>(
+                std::forward<Task>(task));
+        auto future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.emplace([packaged]() { (*packaged)(); });
+        }
+        mTaskAvailable.notify_one();
+        return future;
+    }
+
+    /** @return The number of worker threads */
+    std::size_t size() const;
+
+private:
+
+    /** @brief Run tasks from the queue until the pool is stopped */
+    void workerLoop();
+
+    std::vector<std::thread> mWorkers; /**<@brief Worker threads */
+    std::queue<std::function<void()>> mTasks; /**<@brief Tasks waiting to be run */
+    std::mutex mMutex; /**<@brief Guards mTasks and mStopping */
+    std::condition_variable mTaskAvailable; /**<@brief Signals workers when a task is queued */
+    bool mStopping {false}; /**<@brief Set when the pool is being destroyed */
+
+};
+#endif // THREAD_POOL_H
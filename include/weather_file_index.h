@@ -0,0 +1,159 @@
+/**
+ * @file weather_file_index.h
+ * @date 10/16/2026
+ *
+ * @brief WeatherFileIndex class declaration
+ */
+
+#ifndef WEATHER_FILE_INDEX_H
+#define WEATHER_FILE_INDEX_H
+
+#include "data/weather_data.h"
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @class WeatherFileIndex weather_file_index.h "weather_file_index.h"
+ * @brief An index of the byte offset and date of each weather data object within
+ * a JSON file, used to parse only the data that a query needs.
+ *
+ * The index is built with a single scan of the file that finds each object and its
+ * date, without parsing the numeric data. Data is then parsed on demand by seeking
+ * to the object within the file. The index can be saved as a sidecar file next to
+ * the JSON file, so later queries skip the scan.
+ *
+ * If the file contains multiple objects with the same date, the one appearing last
+ * is used, matching WeatherArchive::addData. Objects without a valid date are skipped.
+ */
+class WeatherFileIndex {
+public:
+
+    /** @brief Location of a single weather data object within the JSON file */
+    struct Entry {
+        WeatherData::data_time time; /**<@brief Timestamp of the object's date */
+        std::uint64_t offset; /**<@brief Byte offset of the object's '{' */
+        std::uint64_t length; /**<@brief Length of the object's text in bytes */
+    };
+
+    /**
+     * @brief Build the index by scanning a JSON weather data file
+     * @param[in] filename Path to the JSON file
+     * @throws jsonparse::IncorrectJson if the file cannot be read, or is not an
+     * array of objects or a single object
+     * @return The index for the file
+     */
+    static WeatherFileIndex build(const std::string& filename) noexcept(false);
+
+    /**
+     * @brief Load the index from the sidecar file of a JSON file
+     *
+     * The sidecar is only used if it was saved for the current version of the JSON file,
+     * i.e. the JSON file's size and modification time have not changed.
+     * @param[in] filename Path to the JSON file (not the sidecar)
+     * @return The index if a valid sidecar exists, otherwise the optional will not be set
+     */
+    static std::optional<WeatherFileIndex> loadSidecar(const std::string& filename);
+
+    /**
+     * @brief Check if a JSON file is in date order using only the header of its sidecar,
+     * without loading the index
+     * @param[in] filename Path to the JSON file (not the sidecar)
+     * @return True if the file's objects are in strictly increasing date order, or
+     * the optional will not be set if there is no valid sidecar
+     */
+    static std::optional<bool> sidecarFileSorted(const std::string& filename);
+
+    /**
+     * @brief Load the index from the JSON file's sidecar, or build it and save the
+     * sidecar if there is no valid sidecar
+     * @param[in] filename Path to the JSON file
+     * @throws jsonparse::IncorrectJson if the index has to be built and building fails
+     * @return The index for the file
+     */
+    static WeatherFileIndex loadOrBuild(const std::string& filename) noexcept(false);
+
+    /**
+     * @brief Get the path of the sidecar file for a JSON file
+     * @param[in] filename Path to the JSON file
+     * @return Path of the sidecar file (the JSON file path with ".idx" appended)
+     */
+    static std::string sidecarFilename(const std::string& filename);
+
+    /**
+     * @brief Save the index as a sidecar file next to the JSON file
+     * @return True if the sidecar was written, false otherwise
+     */
+    bool saveSidecar() const;
+
+    /**
+     * @brief Parse the single data point that matches the input time
+     * @param[in] time Timestamp of the data point
+     * @throws jsonparse::IncorrectJson if the object cannot be read from the file
+     * @return The corresponding WeatherData if the file contains it, otherwise
+     * the optional will not be set
+     */
+    std::optional<WeatherData> retrieve(const WeatherData::data_time time) const noexcept(false);
+
+    /**
+     * @brief Parse the data within a time range
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @throws jsonparse::IncorrectJson if an object cannot be read from the file
+     * @return All data within that time range, sorted by time
+     */
+    std::vector<WeatherData> retrieveRange(
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec) const noexcept(false);
+
+    /** @return Index entries, sorted by time */
+    const std::vector<Entry>& entries() const;
+
+    /** @return True if the objects within the file are in strictly increasing date order */
+    bool fileSorted() const;
+
+private:
+
+    /** @brief Use the static build and load methods to create an index */
+    WeatherFileIndex() = default;
+
+    /**
+     * @brief Parse the object that an entry points to
+     * @param[in] file Open stream of the JSON file
+     * @param[in] entry Entry for the object
+     * @return The parsed weather data
+     */
+    static WeatherData parseEntry(std::istream& file, const Entry& entry) noexcept(false);
+
+    /**
+     * @brief Open the sidecar of a JSON file and read its header
+     * @param[in] filename Path to the JSON file
+     * @param[out] sidecar Stream of the sidecar, positioned at the first entry
+     * @param[out] file_sorted The sorted flag stored in the sidecar
+     * @param[out] entry_count Number of entries stored in the sidecar
+     * @return True if the sidecar exists and was saved for the current JSON file
+     */
+    static bool openSidecar(const std::string& filename, std::ifstream& sidecar,
+            bool& file_sorted, std::uint64_t& entry_count);
+
+    /**
+     * @brief Get the size and modification time of a file, used to detect stale sidecars
+     * @param[in] filename Path to the file
+     * @param[out] size Size of the file in bytes
+     * @param[out] modified_time Modification time of the file, in file clock ticks
+     * @return True if the file's status could be read
+     */
+    static bool fileStamp(const std::string& filename,
+            std::uint64_t& size, std::int64_t& modified_time);
+
+    std::string mFilename; /**<@brief Path to the JSON file */
+    std::uint64_t mFileSize {0}; /**<@brief Size of the JSON file when indexed */
+    std::int64_t mFileTime {0}; /**<@brief Modification time of the JSON file when indexed */
+    bool mFileSorted {true}; /**<@brief The file's objects are in strictly increasing date order */
+    std::vector<Entry> mEntries; /**<@brief Index entries, sorted by time */
+
+};
+#endif // WEATHER_FILE_INDEX_H
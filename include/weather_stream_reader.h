@@ -0,0 +1,60 @@
+/**
+ * @file weather_stream_reader.h
+ * @date 10/16/2026
+ *
+ * @brief WeatherStreamReader class declaration
+ */
+
+#ifndef WEATHER_STREAM_READER_H
+#define WEATHER_STREAM_READER_H
+
+#include "data/weather_data.h"
+
+#include <functional>
+#include <istream>
+
+/**
+ * @class WeatherStreamReader weather_stream_reader.h "weather_stream_reader.h"
+ * @brief Answer date range queries by scanning a stream of JSON weather data once,
+ * using constant memory regardless of the size of the stream.
+ *
+ * Unlike WeatherArchive, the data is visited in the order it appears in the stream,
+ * and data with duplicate dates is visited once per occurrence.
+ */
+class WeatherStreamReader {
+public:
+
+    /**
+     * @brief Constructor
+     * @param[in] input Stream containing a JSON Array of weather data, or a single
+     * weather data object. Must outlive the reader.
+     * @param[in] sorted True if the data within the stream is known to be in strictly
+     * increasing date order, which allows a scan to stop once it passes the end of
+     * the requested range.
+     */
+    WeatherStreamReader(std::istream& input, bool sorted);
+
+    /**
+     * @brief Visit each data point within a time range
+     *
+     * Objects outside of the range are skipped without parsing their numeric data.
+     * The stream is consumed, so a reader can only be scanned once.
+     *
+     * @param[in] begin_sec The beginning of the time range (UTM/GMT time) in seconds
+     * @param[in] end_sec The end of the time range, in seconds
+     * @param[in] visitor Function called with each data point within the range
+     * @throws jsonparse::IncorrectJson if the stream does not contain valid weather data
+     * @return The number of data points visited
+     */
+    std::size_t readRange(
+            const WeatherData::data_time begin_sec,
+            const WeatherData::data_time end_sec,
+            const std::function<void(const WeatherData&)>& visitor) noexcept(false);
+
+private:
+
+    std::istream& mInput; /**<@brief Stream of JSON weather data */
+    bool mSorted; /**<@brief The stream is in strictly increasing date order */
+
+};
+#endif // WEATHER_STREAM_READER_H
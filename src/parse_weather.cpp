@@ -8,16 +8,32 @@
  */
 
 #include "parse_weather_driver.h"
+#include "async_output_buffer.h"
 #include <CLI/CLI.hpp>
+#include <unistd.h>
+#include <iostream>
+#include <optional>
 
 int main(int argc, char** argv) {
 
+    // When stdout is redirected (ex. piped into a compressor), output is written in large
+    // blocks by a separate thread, so formatting overlaps writing. A terminal keeps the
+    // usual buffering, so output is shown as it is produced.
+    std::optional<AsyncOutputBuffer> asyncOutput;
+    std::streambuf* stdoutBuffer = nullptr;
+    if (!isatty(STDOUT_FILENO)) {
+        std::cout.flush();
+        asyncOutput.emplace(STDOUT_FILENO);
+        stdoutBuffer = std::cout.rdbuf(&asyncOutput.value());
+    }
+
     CLI::App app {"A script that accepts a file with JSON formatted weather data and parses "
         "it according to the options below."};
 
     // Driver object that contains member fields for the various input fields
     ParseWeatherDriver driver;
 
+    int result = 0;
     try {
 
         driver.setOptions(app);
@@ -27,8 +43,12 @@ int main(int argc, char** argv) {
         driver.run(app); // can throw CLI::Error 
 
     } catch (const CLI::Error& error) {
-        return app.exit(error);
+        result = app.exit(error);
     } 
 
-    return 0;
+    if (asyncOutput.has_value()) {
+        std::cout.flush();
+        std::cout.rdbuf(stdoutBuffer);
+    }
+    return result;
 }
@@ -0,0 +1,404 @@
+/**
+ * @file arrow_stream_writer.cpp
+ * @date 10/16/2026
+ *
+ * @brief ArrowStreamWriter class definition
+ */
+
+#include "arrow_stream_writer.h"
+#include "json_parse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace {
+    /** @brief Marks the start of each message of an IPC stream */
+    constexpr std::uint32_t Continuation = 0xFFFFFFFF;
+
+    /** @brief MetadataVersion::V5 of Schema.fbs */
+    constexpr std::int16_t MetadataVersion = 4;
+
+    /** @brief MessageHeader union types of Message.fbs */
+    constexpr std::uint8_t SchemaHeader = 1;
+    constexpr std::uint8_t RecordBatchHeader = 3; /**<@copydoc SchemaHeader */
+
+    /** @brief Type union types of Schema.fbs */
+    constexpr std::uint8_t FloatingPointType = 3;
+    constexpr std::uint8_t DateType = 8; /**<@copydoc FloatingPointType */
+
+    /** @brief Precision::SINGLE of Schema.fbs */
+    constexpr std::int16_t SinglePrecision = 1;
+
+    /** @brief DateUnit::DAY of Schema.fbs */
+    constexpr std::int16_t DayUnit = 0;
+
+    /** @brief Number of columns, the date followed by each variable */
+    constexpr std::size_t ColumnCount = 1 + WeatherData::VariableCount;
+
+    /** @brief Variables in column order (sorted by key, like the JSON output) */
+    constexpr WeatherData::Variable ColumnOrder[] = {
+        WeatherData::Variable::GasPpt, WeatherData::Variable::MaxTemp,
+        WeatherData::Variable::MeanTemp, WeatherData::Variable::MinTemp};
+
+    /** @brief Every buffer of a message body is padded to a multiple of this */
+    constexpr std::size_t Alignment = 8;
+
+    /** @brief Days since 1970-01-01 of a Unix time, the value of a date32 */
+    std::int32_t daysSinceEpoch(const WeatherData::data_time time_sec) {
+        return static_cast<std::int32_t>(WeatherData::dayNumber(time_sec));
+    }
+
+    std::size_t padded(const std::size_t size) {
+        return (size + Alignment - 1) / Alignment * Alignment;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writePadding(std::ostream& out, const std::size_t size) {
+        static constexpr char Zeros[Alignment] = {};
+        out.write(Zeros, static_cast<std::streamsize>(padded(size) - size));
+    }
+
+    /**
+     * @brief A minimal FlatBuffers encoder for the metadata of IPC messages.
+     *
+     * Objects are appended front to back, so a table is placed before the objects it
+     * references (FlatBuffers offsets point forward), and its offset fields are set once
+     * those objects are placed.
+     */
+    class FlatBuffer {
+    public:
+
+        /** @brief Position of a table and of each of its fields */
+        struct Table {
+            std::size_t position; /**<@brief Position of the table */
+            std::vector<std::size_t> fields; /**<@brief Position of each field */
+        };
+
+        FlatBuffer() : mBytes(sizeof(std::uint32_t), 0) {} // root offset, set by finish
+
+        /**
+         * @brief Append a table, preceded by its vtable
+         * @param[in] sizes Size of the field of each slot of the table, 0 if it is absent
+         * @return Positions of the table and its fields, which are zero until set
+         */
+        Table table(const std::vector<std::size_t>& sizes) {
+            align(sizeof(std::uint16_t));
+            const auto vtable = mBytes.size();
+            const auto vtableSize = sizeof(std::uint16_t) * (2 + sizes.size());
+            mBytes.resize(mBytes.size() + vtableSize);
+
+            align(sizeof(std::int32_t));
+            Table table {mBytes.size(), std::vector<std::size_t>(sizes.size(), 0)};
+            mBytes.resize(mBytes.size() + sizeof(std::int32_t));
+            set(table.position, static_cast<std::int32_t>(table.position - vtable));
+            for (std::size_t slot = 0; slot < sizes.size(); slot++) {
+                if (sizes[slot] > 0) {
+                    align(sizes[slot]);
+                    table.fields[slot] = mBytes.size();
+                    mBytes.resize(mBytes.size() + sizes[slot]);
+                    set(vtable + sizeof(std::uint16_t) * (2 + slot),
+                            static_cast<std::uint16_t>(table.fields[slot] - table.position));
+                }
+            }
+            set(vtable, static_cast<std::uint16_t>(vtableSize));
+            set(vtable + sizeof(std::uint16_t), static_cast<std::uint16_t>(mBytes.size() - table.position));
+            return table;
+        }
+
+        /**
+         * @brief Append a vector, with its elements set to zero
+         * @param[in] count Number of elements
+         * @param[in] element_size Size of each element (4 for an offset, or a struct size)
+         * @param[in] alignment Alignment of the elements
+         * @return Position of the vector
+         */
+        std::size_t vector(const std::size_t count, const std::size_t element_size,
+                const std::size_t alignment) {
+            // the length is aligned to 4, and the elements that follow it to alignment
+            while (mBytes.size() % sizeof(std::uint32_t) != 0
+                    || (mBytes.size() + sizeof(std::uint32_t)) % alignment != 0) {
+                mBytes.push_back(0);
+            }
+            const auto position = mBytes.size();
+            mBytes.resize(mBytes.size() + sizeof(std::uint32_t) + count * element_size);
+            set(position, static_cast<std::uint32_t>(count));
+            return position;
+        }
+
+        /**
+         * @brief Append a string
+         * @param[in] string The string
+         * @return Position of the string
+         */
+        std::size_t string(const std::string& string) {
+            const auto position = vector(string.size(), 1, 1);
+            std::memcpy(mBytes.data() + position + sizeof(std::uint32_t), string.data(), string.size());
+            mBytes.push_back(0); // null terminated, which the length does not include
+            return position;
+        }
+
+        /**
+         * @brief Set a value
+         * @param[in] position Position of the value (a field or vector element)
+         * @param[in] value The value
+         */
+        template <typename T>
+        void set(const std::size_t position, const T value) {
+            std::memcpy(mBytes.data() + position, &value, sizeof(T));
+        }
+
+        /**
+         * @brief Set an offset to an object
+         * @param[in] position Position of the offset (a field or vector element)
+         * @param[in] object Position of the object, after position
+         */
+        void setOffset(const std::size_t position, const std::size_t object) {
+            set(position, static_cast<std::uint32_t>(object - position));
+        }
+
+        /**
+         * @brief Set the root table and pad the buffer to Alignment
+         * @param[in] root Position of the root table
+         * @return The encoded buffer
+         */
+        const std::vector<std::uint8_t>& finish(const std::size_t root) {
+            setOffset(0, root);
+            align(Alignment);
+            return mBytes;
+        }
+
+    private:
+
+        void align(const std::size_t alignment) {
+            mBytes.resize((mBytes.size() + alignment - 1) / alignment * alignment);
+        }
+
+        std::vector<std::uint8_t> mBytes; /**<@brief The encoded buffer */
+    };
+
+    /**
+     * @brief Append a Message table with its fields other than the header set
+     * @param[in] buffer Buffer of the message
+     * @param[in] header_type MessageHeader union type
+     * @param[in] body_length Size of the message body
+     * @return The Message table
+     */
+    FlatBuffer::Table appendMessage(FlatBuffer& buffer, const std::uint8_t header_type,
+            const std::int64_t body_length) {
+        // version, header_type, header, bodyLength
+        const auto message = buffer.table({2, 1, 4, 8});
+        buffer.set(message.fields[0], MetadataVersion);
+        buffer.set(message.fields[1], header_type);
+        buffer.set(message.fields[3], body_length);
+        return message;
+    }
+
+    /**
+     * @brief Write the encapsulated metadata of a message: the continuation marker, the
+     * metadata size, and the metadata. The body follows the metadata
+     * @param[in] out Stream to write to
+     * @param[in] metadata Metadata padded to Alignment
+     */
+    void writeMetadata(std::ostream& out, const std::vector<std::uint8_t>& metadata) {
+        writeValue(out, Continuation);
+        writeValue(out, static_cast<std::int32_t>(metadata.size()));
+        out.write(reinterpret_cast<const char*>(metadata.data()),
+                static_cast<std::streamsize>(metadata.size()));
+    }
+
+    std::vector<std::uint8_t> schemaMetadata() {
+        FlatBuffer buffer;
+        const auto message = appendMessage(buffer, SchemaHeader, 0);
+
+        // endianness (little by default), fields
+        const auto schema = buffer.table({0, 4});
+        buffer.setOffset(message.fields[2], schema.position);
+        const auto fields = buffer.vector(ColumnCount, 4, 4);
+        buffer.setOffset(schema.fields[1], fields);
+
+        for (std::size_t column = 0; column < ColumnCount; column++) {
+            // name, nullable, type_type, type, dictionary, children
+            const auto field = buffer.table({4, 1, 1, 4, 0, 4});
+            buffer.setOffset(fields + sizeof(std::uint32_t) * (1 + column), field.position);
+            buffer.set(field.fields[1], std::uint8_t{1});
+            buffer.set(field.fields[2], column == 0 ? DateType : FloatingPointType);
+
+            // unit of a Date, or precision of a FloatingPoint
+            const auto type = buffer.table({2});
+            buffer.setOffset(field.fields[3], type.position);
+            buffer.set(type.fields[0], column == 0 ? DayUnit : SinglePrecision);
+
+            buffer.setOffset(field.fields[0], buffer.string(column == 0
+                        ? jsonparse::DATE_KEY : jsonparse::variableToKey(ColumnOrder[column - 1])));
+            buffer.setOffset(field.fields[5], buffer.vector(0, 4, 4));
+        }
+
+        return buffer.finish(message.position);
+    }
+
+    /**
+     * @brief Set the validity bitmap of a column, one bit per row (least significant
+     * bit first), set if the row is not null
+     * @param[in] length Number of rows
+     * @param[in] valid Function returning true if a row is not null
+     * @param[out] bitmap The bitmap, padded to Alignment
+     * @return The number of null rows
+     */
+    template <typename Valid>
+    std::int64_t setBitmap(const std::size_t length, const Valid& valid, std::vector<std::uint8_t>& bitmap) {
+        bitmap.assign(padded((length + 7) / 8), 0);
+        std::int64_t nullCount = 0;
+        for (std::size_t row = 0; row < length; row++) {
+            if (valid(row)) {
+                bitmap[row / 8] |= static_cast<std::uint8_t>(1u << (row % 8));
+            } else {
+                nullCount++;
+            }
+        }
+        return nullCount;
+    }
+}
+
+ArrowStreamWriter::ArrowStreamWriter(std::ostream& out) : mOut(out) {
+    writeMetadata(mOut, schemaMetadata());
+}
+
+void ArrowStreamWriter::write(const WeatherData& data) {
+    if (data.time.has_value()) {
+        mDays.push_back(daysSinceEpoch(data.time.value()));
+        mDateValid.push_back(1);
+    } else {
+        mDays.push_back(0);
+        mDateValid.push_back(0);
+    }
+    for (std::size_t variable = 0; variable < WeatherData::VariableCount; variable++) {
+        const auto& value = data.value(static_cast<WeatherData::Variable>(variable));
+        mValues[variable].push_back(value.value_or(std::nanf("")));
+    }
+
+    if (mDays.size() == BatchSize) {
+        flush();
+    }
+}
+
+void ArrowStreamWriter::write(const WeatherColumns& columns, const std::size_t first,
+        const std::size_t last) {
+    flush(); // keep the order of the data
+
+    const auto& times = columns.times();
+    std::vector<std::int32_t> days;
+    for (auto batchFirst = first; batchFirst < last; batchFirst += BatchSize) {
+        const auto length = std::min(BatchSize, last - batchFirst);
+        days.resize(length);
+        for (std::size_t row = 0; row < length; row++) {
+            days[row] = daysSinceEpoch(times[batchFirst + row]);
+        }
+
+        std::array<const float*, WeatherData::VariableCount> values;
+        for (std::size_t variable = 0; variable < WeatherData::VariableCount; variable++) {
+            values[variable] = columns.values(static_cast<WeatherData::Variable>(variable)).data() + batchFirst;
+        }
+        writeBatch(length, days.data(), nullptr, values);
+    }
+}
+
+void ArrowStreamWriter::close() {
+    flush();
+    writeValue(mOut, Continuation);
+    writeValue(mOut, std::int32_t{0});
+}
+
+void ArrowStreamWriter::flush() {
+    if (mDays.empty()) {
+        return;
+    }
+
+    std::array<const float*, WeatherData::VariableCount> values;
+    for (std::size_t variable = 0; variable < WeatherData::VariableCount; variable++) {
+        values[variable] = mValues[variable].data();
+    }
+    writeBatch(mDays.size(), mDays.data(), mDateValid.data(), values);
+
+    mDays.clear();
+    mDateValid.clear();
+    for (auto& values : mValues) {
+        values.clear();
+    }
+}
+
+void ArrowStreamWriter::writeBatch(
+        const std::size_t length,
+        const std::int32_t* days,
+        const std::uint8_t* date_valid,
+        const std::array<const float*, WeatherData::VariableCount>& values) {
+
+    // the null counts are part of the metadata, so the bitmaps are set first
+    std::array<std::vector<std::uint8_t>, ColumnCount> bitmaps;
+    std::array<std::int64_t, ColumnCount> nullCounts;
+    std::array<const void*, ColumnCount> columnValues;
+    std::array<std::size_t, ColumnCount> valueSizes;
+    nullCounts[0] = setBitmap(length, [date_valid](const std::size_t row) {
+        return date_valid == nullptr || date_valid[row] != 0;
+    }, bitmaps[0]);
+    columnValues[0] = days;
+    valueSizes[0] = length * sizeof(std::int32_t);
+    for (std::size_t column = 1; column < ColumnCount; column++) {
+        const auto* columnData = values[static_cast<std::size_t>(ColumnOrder[column - 1])];
+        nullCounts[column] = setBitmap(length, [columnData](const std::size_t row) {
+            return !std::isnan(columnData[row]);
+        }, bitmaps[column]);
+        columnValues[column] = columnData;
+        valueSizes[column] = length * sizeof(float);
+    }
+
+    // the body holds the validity bitmap then the values of each column
+    FlatBuffer buffer;
+    std::int64_t bodyLength = 0;
+    for (std::size_t column = 0; column < ColumnCount; column++) {
+        bodyLength += static_cast<std::int64_t>(bitmaps[column].size() + padded(valueSizes[column]));
+    }
+    const auto message = appendMessage(buffer, RecordBatchHeader, bodyLength);
+
+    // length, nodes, buffers
+    const auto batch = buffer.table({8, 4, 4});
+    buffer.setOffset(message.fields[2], batch.position);
+    buffer.set(batch.fields[0], static_cast<std::int64_t>(length));
+
+    // FieldNode structs: length, null_count
+    const auto nodes = buffer.vector(ColumnCount, 16, 8);
+    buffer.setOffset(batch.fields[1], nodes);
+    for (std::size_t column = 0; column < ColumnCount; column++) {
+        const auto node = nodes + sizeof(std::uint32_t) + 16 * column;
+        buffer.set(node, static_cast<std::int64_t>(length));
+        buffer.set(node + 8, nullCounts[column]);
+    }
+
+    // Buffer structs: offset, length
+    const auto buffers = buffer.vector(2 * ColumnCount, 16, 8);
+    buffer.setOffset(batch.fields[2], buffers);
+    std::int64_t offset = 0;
+    for (std::size_t column = 0; column < ColumnCount; column++) {
+        const auto bitmap = buffers + sizeof(std::uint32_t) + 32 * column;
+        buffer.set(bitmap, offset);
+        buffer.set(bitmap + 8, static_cast<std::int64_t>(bitmaps[column].size()));
+        offset += static_cast<std::int64_t>(bitmaps[column].size());
+        buffer.set(bitmap + 16, offset);
+        buffer.set(bitmap + 24, static_cast<std::int64_t>(valueSizes[column]));
+        offset += static_cast<std::int64_t>(padded(valueSizes[column]));
+    }
+
+    writeMetadata(mOut, buffer.finish(message.position));
+    for (std::size_t column = 0; column < ColumnCount; column++) {
+        mOut.write(reinterpret_cast<const char*>(bitmaps[column].data()),
+                static_cast<std::streamsize>(bitmaps[column].size()));
+        mOut.write(static_cast<const char*>(columnValues[column]),
+                static_cast<std::streamsize>(valueSizes[column]));
+        writePadding(mOut, valueSizes[column]);
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file async_output_buffer.cpp
+ * @date 10/16/2026
+ *
+ * @brief AsyncOutputBuffer class definition
+ */
+
+#include "async_output_buffer.h"
+
+#include <sys/uio.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
+namespace {
+    /**
+     * @brief Write every byte of the buffers, continuing after partial writes
+     * @param[in] fd File descriptor to write to
+     * @param[in,out] buffers The buffers, which are advanced past the written bytes
+     * @return True if everything was written
+     */
+    bool writeAll(const int fd, std::vector<iovec>& buffers) {
+        std::size_t first = 0;
+        while (first < buffers.size()) {
+            const auto count = std::min<std::size_t>(buffers.size() - first, IOV_MAX);
+            const auto written = ::writev(fd, buffers.data() + first, static_cast<int>(count));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+
+            auto remaining = static_cast<std::size_t>(written);
+            while (first < buffers.size() && remaining >= buffers[first].iov_len) {
+                remaining -= buffers[first].iov_len;
+                first++;
+            }
+            if (first < buffers.size()) {
+                buffers[first].iov_base = static_cast<char*>(buffers[first].iov_base) + remaining;
+                buffers[first].iov_len -= remaining;
+            }
+        }
+        return true;
+    }
+}
+
+AsyncOutputBuffer::AsyncOutputBuffer(
+        const int fd,
+        const std::size_t block_size,
+        const std::size_t block_count) :
+    mFd(fd),
+    mBlocks(std::max<std::size_t>(block_count, 2), std::vector<char>(std::max<std::size_t>(block_size, 1))) {
+
+    for (std::size_t block = 1; block < mBlocks.size(); ++block) {
+        mFree.push_back(block);
+    }
+    setp(mBlocks[mCurrent].data(), mBlocks[mCurrent].data() + mBlocks[mCurrent].size());
+    mWriter = std::thread([this]() { run(); });
+}
+
+AsyncOutputBuffer::~AsyncOutputBuffer() {
+    sync();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mChanged.notify_all();
+    mWriter.join();
+}
+
+AsyncOutputBuffer::int_type AsyncOutputBuffer::overflow(int_type ch) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    handOff(lock);
+    if (mFailed) {
+        return traits_type::eof();
+    }
+    lock.unlock();
+
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int AsyncOutputBuffer::sync() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    handOff(lock);
+
+    // every block other than the current one is free once everything is written
+    mChanged.wait(lock, [this]() { return mPending.empty() && mFree.size() + 1 == mBlocks.size(); });
+    return mFailed ? -1 : 0;
+}
+
+void AsyncOutputBuffer::handOff(std::unique_lock<std::mutex>& lock) {
+    const auto size = static_cast<std::size_t>(pptr() - pbase());
+    if (size > 0) {
+        mPending.emplace_back(mCurrent, size);
+        mChanged.notify_all();
+        mChanged.wait(lock, [this]() { return !mFree.empty(); });
+        mCurrent = mFree.back();
+        mFree.pop_back();
+    }
+    setp(mBlocks[mCurrent].data(), mBlocks[mCurrent].data() + mBlocks[mCurrent].size());
+}
+
+void AsyncOutputBuffer::run() {
+    std::vector<iovec> buffers;
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mChanged.wait(lock, [this]() { return mStop || !mPending.empty(); });
+        // write any remaining blocks before stopping
+        if (mPending.empty()) {
+            return;
+        }
+
+        // the pending blocks are only touched by this thread until they are freed
+        const auto blocks = std::move(mPending);
+        mPending.clear();
+        const bool discard = mFailed; // output after a failed write is discarded
+        lock.unlock();
+
+        buffers.clear();
+        for (const auto& [block, size] : blocks) {
+            buffers.push_back({mBlocks[block].data(), size});
+        }
+        const bool written = discard || writeAll(mFd, buffers);
+
+        lock.lock();
+        mFailed = mFailed || !written;
+        for (const auto& block : blocks) {
+            mFree.push_back(block.first);
+        }
+        mChanged.notify_all();
+    }
+}
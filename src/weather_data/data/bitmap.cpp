@@ -0,0 +1,123 @@
+/**
+ * @file bitmap.cpp
+ * @date 10/16/2026
+ *
+ * @brief Bitmap class definition
+ */
+
+#include "data/bitmap.h"
+
+#include <algorithm>
+#include <bitset>
+
+namespace {
+    constexpr std::uint32_t ChunkBits = 65536; /**<@brief Number of positions in a chunk */
+    constexpr std::size_t WordCount = ChunkBits / 64; /**<@brief Number of words in a bitset */
+
+    /** @brief Count the set bits of a word */
+    std::size_t popcount(const std::uint64_t word) {
+        return std::bitset<64>(word).count();
+    }
+}
+
+void Bitmap::Chunk::add(const std::uint16_t low) {
+    ++size;
+    if (isBitset()) {
+        bits[low / 64] |= std::uint64_t{1} << (low % 64);
+        return;
+    }
+
+    array.push_back(low);
+    if (array.size() > ArrayLimit) {
+        bits.assign(WordCount, 0);
+        for (const auto value : array) {
+            bits[value / 64] |= std::uint64_t{1} << (value % 64);
+        }
+        array.clear();
+        array.shrink_to_fit();
+    }
+}
+
+std::size_t Bitmap::Chunk::count(const std::uint32_t first, const std::uint32_t last) const {
+    if (first == 0 && last == ChunkBits) {
+        return size;
+    }
+
+    if (!isBitset()) {
+        return std::lower_bound(array.cbegin(), array.cend(), last)
+            - std::lower_bound(array.cbegin(), array.cend(), first);
+    }
+
+    std::size_t total = 0;
+    auto position = first;
+    // partial words at the ends are masked, whole words are counted with popcount
+    while (position < last) {
+        const auto word = position / 64;
+        const auto offset = position % 64;
+        const auto end = std::min<std::uint32_t>(last, (word + 1) * 64);
+        auto bitsInWord = bits[word] >> offset;
+        const auto width = end - position;
+        if (width < 64) {
+            bitsInWord &= (std::uint64_t{1} << width) - 1;
+        }
+        total += popcount(bitsInWord);
+        position = end;
+    }
+    return total;
+}
+
+void Bitmap::append(const std::uint32_t position) {
+    const auto key = static_cast<std::uint16_t>(position >> 16);
+    if (mChunks.empty() || mChunks.back().key != key) {
+        mChunks.push_back(Chunk{key, {}, {}, 0});
+    }
+    mChunks.back().add(static_cast<std::uint16_t>(position & 0xFFFF));
+}
+
+std::size_t Bitmap::count(const std::uint32_t first, const std::uint32_t last) const {
+    std::size_t total = 0;
+    for (const auto& chunk : mChunks) {
+        const std::uint32_t base = static_cast<std::uint32_t>(chunk.key) << 16;
+        if (base >= last) {
+            break;
+        }
+        if (std::uint64_t{base} + ChunkBits <= first) {
+            continue;
+        }
+        total += chunk.count(std::max(first, base) - base, std::min(last - base, ChunkBits));
+    }
+    return total;
+}
+
+void Bitmap::forEach(const std::uint32_t first,
+        const std::uint32_t last,
+        const std::function<void(std::uint32_t)>& visitor) const {
+    for (const auto& chunk : mChunks) {
+        const std::uint32_t base = static_cast<std::uint32_t>(chunk.key) << 16;
+        if (base >= last) {
+            break;
+        }
+        if (std::uint64_t{base} + ChunkBits <= first) {
+            continue;
+        }
+
+        if (chunk.isBitset()) {
+            for (std::size_t word = 0; word < WordCount; ++word) {
+                for (auto bitsInWord = chunk.bits[word]; bitsInWord != 0; bitsInWord &= bitsInWord - 1) {
+                    const auto position = base + static_cast<std::uint32_t>(
+                            word * 64 + popcount((bitsInWord & -bitsInWord) - 1));
+                    if (position >= first && position < last) {
+                        visitor(position);
+                    }
+                }
+            }
+        } else {
+            for (const auto low : chunk.array) {
+                const auto position = base | low;
+                if (position >= first && position < last) {
+                    visitor(position);
+                }
+            }
+        }
+    }
+}
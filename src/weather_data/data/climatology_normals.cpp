@@ -0,0 +1,90 @@
+/**
+ * @file climatology_normals.cpp
+ * @date 10/16/2026
+ *
+ * @brief ClimatologyNormals class definition
+ */
+
+#include "data/climatology_normals.h"
+
+#include "date/date.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    /** @brief Index of the first day of each month within a leap year, then 366 */
+    constexpr std::size_t MonthStart[] = {
+        0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366};
+
+    /** @brief Get the timestamp of January 1st of a year */
+    WeatherData::data_time yearStart(const int year) {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                date::sys_days{date::year{year}/1/1}.time_since_epoch()).count();
+    }
+}
+
+ClimatologyNormals::ClimatologyNormals(
+        const WeatherColumns& columns,
+        const int first_year,
+        const int last_year) :
+    mFirstYear(first_year),
+    mLastYear(last_year) {
+    if (first_year > last_year) {
+        return;
+    }
+
+    const auto range = columns.range(yearStart(first_year), yearStart(last_year + 1) - 1);
+    const auto& times = columns.times();
+
+    // find the calendar day of each data point once, then summarize each column by day
+    std::vector<std::uint16_t> dayIndices;
+    dayIndices.reserve(range.second - range.first);
+    for (auto i = range.first; i < range.second; ++i) {
+        const date::year_month_day ymd{date::floor<date::days>(
+                date::sys_seconds{std::chrono::seconds{times[i]}})};
+        const auto index = dayIndex(
+                static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+        dayIndices.push_back(static_cast<std::uint16_t>(index));
+        ++mDays[index].count;
+    }
+
+    for (std::size_t v = 0; v < WeatherData::VariableCount; ++v) {
+        const auto& values = columns.values(static_cast<WeatherData::Variable>(v));
+        for (std::size_t i = 0; i < dayIndices.size(); ++i) {
+            const auto value = values[range.first + i];
+            if (!std::isnan(value)) {
+                mDays[dayIndices[i]].variables[v].add(value);
+            }
+        }
+    }
+}
+
+int ClimatologyNormals::firstYear() const {
+    return mFirstYear;
+}
+
+int ClimatologyNormals::lastYear() const {
+    return mLastYear;
+}
+
+const WeatherSummary& ClimatologyNormals::day(const unsigned month, const unsigned day) const {
+    const auto index = dayIndex(month, day);
+    if (index == DayCount) {
+        throw std::out_of_range("Not a calendar day");
+    }
+    return mDays[index];
+}
+
+const std::array<WeatherSummary, ClimatologyNormals::DayCount>& ClimatologyNormals::days() const {
+    return mDays;
+}
+
+std::size_t ClimatologyNormals::dayIndex(const unsigned month, const unsigned day) {
+    if (month < 1 || month > 12 || day < 1 || day > MonthStart[month] - MonthStart[month - 1]) {
+        return DayCount;
+    }
+    return MonthStart[month - 1] + day - 1;
+}
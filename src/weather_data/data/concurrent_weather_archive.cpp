@@ -0,0 +1,74 @@
+/**
+ * @file concurrent_weather_archive.cpp
+ * @date 10/16/2026
+ *
+ * @brief ConcurrentWeatherArchive class definition
+ */
+
+#include "data/concurrent_weather_archive.h"
+
+#include <algorithm>
+
+ConcurrentWeatherArchive::ConcurrentWeatherArchive(
+        WeatherArchive archive,
+        const std::size_t batch_size) :
+    mpPublished(std::make_shared<const WeatherArchive>(std::move(archive))),
+    mBatchSize(std::max<std::size_t>(batch_size, 1)) {}
+
+ConcurrentWeatherArchive::Snapshot ConcurrentWeatherArchive::snapshot() const {
+    return std::atomic_load(&mpPublished);
+}
+
+std::optional<WeatherData> ConcurrentWeatherArchive::retrieve(
+        const WeatherData::data_time time) const {
+    return snapshot()->retrieve(time);
+}
+
+std::vector<WeatherData> ConcurrentWeatherArchive::retrieveRange(
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    return snapshot()->retrieveRange(begin_sec, end_sec);
+}
+
+void ConcurrentWeatherArchive::addData(const WeatherData& data) {
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    mPending.push_back(data);
+    if (mPending.size() >= mBatchSize) {
+        publishLocked();
+    }
+}
+
+void ConcurrentWeatherArchive::addBatch(std::vector<WeatherData>&& data) {
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    if (mPending.empty()) {
+        mPending = std::move(data);
+    } else {
+        mPending.insert(mPending.end(),
+                std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
+    }
+    publishLocked();
+}
+
+void ConcurrentWeatherArchive::publish() {
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    publishLocked();
+}
+
+std::uint64_t ConcurrentWeatherArchive::version() const {
+    return mVersion.load();
+}
+
+void ConcurrentWeatherArchive::publishLocked() {
+    if (mPending.empty()) {
+        return;
+    }
+
+    // only writers replace mpPublished, and they hold mWriterMutex, so the current
+    // version cannot change while the new version is built
+    auto nextVersion = std::make_shared<WeatherArchive>(*std::atomic_load(&mpPublished));
+    nextVersion->addBatch(std::move(mPending));
+    mPending.clear();
+
+    std::atomic_store(&mpPublished, Snapshot(std::move(nextVersion)));
+    ++mVersion;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file counter_random.cpp
+ * @date 10/16/2026
+ *
+ * @brief CounterRandom class definition
+ */
+
+#include "data/counter_random.h"
+
+namespace {
+    /** @brief Philox4x32 round multipliers */
+    constexpr std::uint32_t Multiplier0 = 0xD2511F53;
+    constexpr std::uint32_t Multiplier1 = 0xCD9E8D57;
+
+    /** @brief Philox4x32 key schedule increments (Weyl sequence) */
+    constexpr std::uint32_t KeyIncrement0 = 0x9E3779B9;
+    constexpr std::uint32_t KeyIncrement1 = 0xBB67AE85;
+
+    /** @brief Number of rounds, 10 is the standard and passes BigCrush */
+    constexpr int RoundCount = 10;
+}
+
+CounterRandom::CounterRandom(const std::uint64_t seed) : mSeed(seed) {}
+
+std::uint64_t CounterRandom::seed() const {
+    return mSeed;
+}
+
+CounterRandom::Block CounterRandom::generate(
+        const std::uint64_t counter,
+        const std::uint64_t stream) const {
+    Block block {
+        static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32),
+        static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)};
+    auto key0 = static_cast<std::uint32_t>(mSeed);
+    auto key1 = static_cast<std::uint32_t>(mSeed >> 32);
+
+    for (auto round = 0; round < RoundCount; ++round) {
+        const auto product0 = static_cast<std::uint64_t>(Multiplier0) * block[0];
+        const auto product1 = static_cast<std::uint64_t>(Multiplier1) * block[2];
+        block = {
+            static_cast<std::uint32_t>(product1 >> 32) ^ block[1] ^ key0,
+            static_cast<std::uint32_t>(product1),
+            static_cast<std::uint32_t>(product0 >> 32) ^ block[3] ^ key1,
+            static_cast<std::uint32_t>(product0)};
+        key0 += KeyIncrement0;
+        key1 += KeyIncrement1;
+    }
+
+    return block;
+}
+
+std::uint32_t CounterRandom::uniform(
+        const std::uint64_t counter,
+        const std::uint32_t n,
+        const std::uint64_t stream) const {
+    return scale(generate(counter, stream)[0], n);
+}
+
+std::uint32_t CounterRandom::scale(const std::uint32_t bits, const std::uint32_t n) {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(bits) * n) >> 32);
+}
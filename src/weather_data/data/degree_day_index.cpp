@@ -0,0 +1,107 @@
+/**
+ * @file degree_day_index.cpp
+ * @date 10/16/2026
+ *
+ * @brief DegreeDayIndex class definition
+ */
+
+#include "data/degree_day_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+DegreeDayIndex::Temperatures::Temperatures(const WeatherColumns& columns) :
+    monthStarts(columns.monthStarts()) {
+    const auto& means = columns.values(WeatherData::Variable::MeanTemp);
+    const auto& maxes = columns.values(WeatherData::Variable::MaxTemp);
+    const auto& mins = columns.values(WeatherData::Variable::MinTemp);
+
+    // fall back to the average of the max and min, which is NaN if either is missing
+    values.resize(columns.size());
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        values[i] = std::isnan(means[i]) ? (maxes[i] + mins[i]) / 2 : means[i];
+    }
+}
+
+DegreeDayIndex::DegreeDayIndex(std::shared_ptr<const Temperatures> temperatures, const float base) :
+    mBase(base),
+    mTemperatures(std::move(temperatures)) {
+    const auto& monthStarts = mTemperatures->monthStarts;
+    mMonthPrefix.resize(monthStarts.size());
+    for (std::size_t month = 0; month + 1 < monthStarts.size(); ++month) {
+        const auto totals = accumulate(monthStarts[month], monthStarts[month + 1]);
+        mMonthPrefix[month + 1].heating = mMonthPrefix[month].heating + totals.heating;
+        mMonthPrefix[month + 1].cooling = mMonthPrefix[month].cooling + totals.cooling;
+        mMonthPrefix[month + 1].count = mMonthPrefix[month].count + totals.count;
+    }
+}
+
+DegreeDayIndex::DegreeDays DegreeDayIndex::query(const std::size_t first, const std::size_t last) const {
+    if (first >= last) {
+        return DegreeDays();
+    }
+
+    // whole months within the range, [firstMonth, lastMonth)
+    const auto& monthStarts = mTemperatures->monthStarts;
+    const auto firstMonth = static_cast<std::size_t>(
+            std::lower_bound(monthStarts.cbegin(), monthStarts.cend(), first) - monthStarts.cbegin());
+    const auto lastMonth = static_cast<std::size_t>(
+            std::upper_bound(monthStarts.cbegin(), monthStarts.cend(), last) - monthStarts.cbegin()) - 1;
+    if (firstMonth >= lastMonth) {
+        return accumulate(first, last);
+    }
+
+    auto totals = accumulate(first, monthStarts[firstMonth]);
+    const auto end = accumulate(monthStarts[lastMonth], last);
+    totals.heating += end.heating + mMonthPrefix[lastMonth].heating - mMonthPrefix[firstMonth].heating;
+    totals.cooling += end.cooling + mMonthPrefix[lastMonth].cooling - mMonthPrefix[firstMonth].cooling;
+    totals.count += end.count + mMonthPrefix[lastMonth].count - mMonthPrefix[firstMonth].count;
+    return totals;
+}
+
+DegreeDayIndex::DegreeDays DegreeDayIndex::accumulate(const std::size_t first, const std::size_t last) const {
+    // Each lane keeps its own float sums and count, so the lanes of a block are
+    // independent and the loop vectorizes without reassociating a single sum. A missing
+    // temperature is replaced by the base, which gives 0 degree days, and is masked out
+    // of the count. The lanes are added to the double totals after every chunk so long
+    // ranges keep their precision.
+    constexpr std::size_t Lanes = 16;
+    constexpr std::size_t ChunkSize = 1024;
+    const float* __restrict temperatures = mTemperatures->values.data();
+    const float base = mBase;
+
+    DegreeDays totals;
+    auto i = first;
+    while (i < last) {
+        float heating[Lanes] = {};
+        float cooling[Lanes] = {};
+        std::uint32_t counts[Lanes] = {};
+
+        const auto end = i + std::min(ChunkSize, last - i);
+        for (; i + Lanes <= end; i += Lanes) {
+            for (std::size_t lane = 0; lane < Lanes; ++lane) {
+                const auto temperature = temperatures[i + lane];
+                const auto blended = temperature == temperature ? temperature : base;
+                heating[lane] += std::max(0.0f, base - blended);
+                cooling[lane] += std::max(0.0f, blended - base);
+                counts[lane] += temperature == temperature ? 1 : 0;
+            }
+        }
+        for (std::size_t lane = 0; i < end; ++i, ++lane) {
+            const auto temperature = temperatures[i];
+            const auto blended = temperature == temperature ? temperature : base;
+            heating[lane] += std::max(0.0f, base - blended);
+            cooling[lane] += std::max(0.0f, blended - base);
+            counts[lane] += temperature == temperature ? 1 : 0;
+        }
+
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            totals.heating += heating[lane];
+            totals.cooling += cooling[lane];
+            totals.count += counts[lane];
+        }
+    }
+    return totals;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file historical_sampler.cpp
+ * @date 10/16/2026
+ *
+ * @brief HistoricalSampler class definition
+ */
+
+#include "data/historical_sampler.h"
+#include "thread_pool.h"
+
+#include "date/date.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace {
+    /** @brief Get the timestamp of January 1st of a year */
+    WeatherData::data_time yearStart(const int year) {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                date::sys_days{date::year{year}/1/1}.time_since_epoch()).count();
+    }
+
+    /** @brief Get the calendar day index (see ClimatologyNormals::dayIndex) of a date */
+    std::size_t calendarDay(const std::int64_t day_number) {
+        const date::year_month_day ymd{date::sys_days{date::days{day_number}}};
+        return ClimatologyNormals::dayIndex(
+                static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+    }
+}
+
+HistoricalSampler::HistoricalSampler(
+        const WeatherColumns& columns,
+        const int first_year,
+        const int last_year,
+        const std::vector<double>& year_weights) {
+    if (first_year > last_year) {
+        return;
+    }
+
+    const auto begin = yearStart(first_year);
+    const auto end = yearStart(last_year + 1);
+    mFirstDay = WeatherData::dayNumber(begin);
+    mDayPositions.assign(static_cast<std::size_t>(WeatherData::dayNumber(end) - mFirstDay), NoData);
+
+    const auto range = columns.range(begin, end - 1);
+    const auto& times = columns.times();
+    const auto yearWeight = [&](const int year) {
+        const auto index = static_cast<std::size_t>(year - first_year);
+        return index < year_weights.size() ? year_weights[index] : (year_weights.empty() ? 1.0 : 0.0);
+    };
+
+    // find the day and calendar day of the data of every year with a weight
+    std::vector<std::uint32_t> days;
+    std::vector<std::uint16_t> dayIndices;
+    days.reserve(range.second - range.first);
+    dayIndices.reserve(range.second - range.first);
+    for (auto i = range.first; i < range.second; ++i) {
+        const auto dayNumber = WeatherData::dayNumber(times[i]);
+        const date::year_month_day ymd{date::sys_days{date::days{dayNumber}}};
+        if (!(yearWeight(static_cast<int>(ymd.year())) > 0)) {
+            continue;
+        }
+
+        const auto day = static_cast<std::uint32_t>(dayNumber - mFirstDay);
+        const auto index = ClimatologyNormals::dayIndex(
+                static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+        mDayPositions[day] = i;
+        days.push_back(day);
+        dayIndices.push_back(static_cast<std::uint16_t>(index));
+        ++mOffsets[index + 1];
+    }
+
+    // counting sort of the days by calendar day, which keeps them in year order
+    for (std::size_t day = 1; day < mOffsets.size(); ++day) {
+        mOffsets[day] += mOffsets[day - 1];
+    }
+    mDays.resize(days.size());
+    auto next = mOffsets;
+    for (std::size_t i = 0; i < days.size(); ++i) {
+        mDays[next[dayIndices[i]]++] = days[i];
+    }
+
+    if (year_weights.empty()) {
+        return; // every year is equally likely, no alias tables are needed
+    }
+
+    // build the alias table of each calendar day (Vose's method)
+    mAcceptance.resize(mDays.size());
+    mAlias.resize(mDays.size());
+    std::vector<double> scaled;
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t index = 0; index < ClimatologyNormals::DayCount; ++index) {
+        const auto first = mOffsets[index];
+        const auto count = mOffsets[index + 1] - first;
+        double total = 0;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            total += yearWeight(yearOf(mDays[first + i]));
+        }
+
+        scaled.clear();
+        small.clear();
+        large.clear();
+        for (std::uint32_t i = 0; i < count; ++i) {
+            scaled.push_back(yearWeight(yearOf(mDays[first + i])) * count / total);
+            (scaled.back() < 1 ? small : large).push_back(i);
+        }
+
+        while (!small.empty() && !large.empty()) {
+            const auto less = small.back();
+            const auto more = large.back();
+            small.pop_back();
+            mAcceptance[first + less] = static_cast<std::uint64_t>(scaled[less] * AcceptanceScale);
+            mAlias[first + less] = more;
+
+            // the remainder of the column of less is taken from more
+            scaled[more] -= 1 - scaled[less];
+            if (scaled[more] < 1) {
+                large.pop_back();
+                small.push_back(more);
+            }
+        }
+
+        // what is left has a probability of 1, up to rounding
+        for (const auto i : large) {
+            mAcceptance[first + i] = AcceptanceScale;
+            mAlias[first + i] = i;
+        }
+        for (const auto i : small) {
+            mAcceptance[first + i] = AcceptanceScale;
+            mAlias[first + i] = i;
+        }
+    }
+}
+
+std::size_t HistoricalSampler::available(const unsigned month, const unsigned day) const {
+    const auto index = ClimatologyNormals::dayIndex(month, day);
+    if (index == ClimatologyNormals::DayCount) {
+        return 0;
+    }
+    return mOffsets[index + 1] - mOffsets[index];
+}
+
+std::size_t HistoricalSampler::draw(
+        const CounterRandom& random,
+        const std::int64_t day_number,
+        const std::uint64_t member) const {
+    const auto day = drawDay(random, day_number, member);
+    return day == NoDay ? NoData : mDayPositions[day];
+}
+
+std::size_t HistoricalSampler::drawInBlock(
+        const CounterRandom& random,
+        const std::int64_t block_day,
+        const std::int64_t offset,
+        const std::uint64_t member) const {
+    // follow the day drawn for the start of the block, consecutive dates keep consecutive
+    // data even if the calendar shifts by a day around February 29th
+    const auto blockStart = drawDay(random, block_day, member);
+    if (blockStart != NoDay) {
+        const auto day = static_cast<std::size_t>(blockStart) + static_cast<std::size_t>(offset);
+        if (day < mDayPositions.size() && mDayPositions[day] != NoData) {
+            return mDayPositions[day];
+        }
+    }
+
+    return draw(random, block_day + offset, member);
+}
+
+std::uint32_t HistoricalSampler::drawDay(
+        const CounterRandom& random,
+        const std::int64_t day_number,
+        const std::uint64_t member) const {
+    const auto index = calendarDay(day_number);
+    const auto count = mOffsets[index + 1] - mOffsets[index];
+    if (count == 0) {
+        return NoDay;
+    }
+
+    const auto bits = random.generate(static_cast<std::uint64_t>(day_number), member);
+    const auto column = mOffsets[index] + CounterRandom::scale(bits[0], count);
+    if (mAlias.empty() || bits[1] < mAcceptance[column]) {
+        return mDays[column];
+    }
+    return mDays[mOffsets[index] + mAlias[column]];
+}
+
+int HistoricalSampler::yearOf(const std::uint32_t day) const {
+    const date::year_month_day ymd{date::sys_days{date::days{mFirstDay + day}}};
+    return static_cast<int>(ymd.year());
+}
+
+std::vector<std::size_t> HistoricalSampler::sample(
+        const CounterRandom& random,
+        const std::int64_t first_day,
+        const std::size_t day_count,
+        const std::size_t thread_count,
+        const std::uint64_t member,
+        const std::size_t block_length) const {
+    const auto blockLength = static_cast<std::int64_t>(std::max<std::size_t>(block_length, 1));
+    std::vector<std::size_t> positions(day_count);
+    const auto chunkCount = (day_count + ChunkSize - 1) / ChunkSize;
+    const auto sampleChunks = [&](std::atomic<std::size_t>& nextChunk) {
+        for (auto chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            const auto chunkLast = std::min((chunk + 1) * ChunkSize, day_count);
+            for (auto i = chunk * ChunkSize; i < chunkLast; ++i) {
+                const auto day = static_cast<std::int64_t>(i);
+                positions[i] = drawInBlock(random,
+                        first_day + day - day % blockLength, day % blockLength, member);
+            }
+        }
+    };
+
+    // every draw only depends on its date, so the chunks can be sampled in any order
+    std::atomic<std::size_t> nextChunk {0};
+    const auto threadCount = std::min(std::max<std::size_t>(thread_count, 1), chunkCount);
+    if (threadCount <= 1) {
+        sampleChunks(nextChunk);
+    } else {
+        ThreadPool pool(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            pool.submit([&]() { sampleChunks(nextChunk); });
+        }
+    } // pool waits for all chunks to be sampled
+
+    return positions;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file quantile_index.cpp
+ * @date 10/16/2026
+ *
+ * @brief QuantileIndex class definition
+ */
+
+#include "data/quantile_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+namespace {
+    /** @brief Add the measurements of [first, last) to a sketch */
+    void addValues(QuantileSketch& sketch,
+            const std::vector<float>& values,
+            const std::size_t first,
+            const std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            if (!std::isnan(values[i])) {
+                sketch.add(values[i]);
+            }
+        }
+    }
+}
+
+QuantileIndex::QuantileIndex(
+        std::shared_ptr<const WeatherColumns> columns,
+        const WeatherData::Variable variable) :
+    mColumns(std::move(columns)),
+    mValues(mColumns->values(variable)),
+    mMonthStarts(mColumns->monthStarts()) {
+    mMonthSketches.resize(mMonthStarts.size() - 1);
+    for (std::size_t month = 0; month < mMonthSketches.size(); ++month) {
+        addValues(mMonthSketches[month], mValues, mMonthStarts[month], mMonthStarts[month + 1]);
+    }
+}
+
+std::optional<float> QuantileIndex::query(
+        const std::size_t first,
+        const std::size_t last,
+        const double fraction) const {
+    if (first >= last) {
+        return std::nullopt;
+    }
+
+    if (last - first <= ExactLimit) {
+        std::vector<float> measurements;
+        measurements.reserve(last - first);
+        std::copy_if(mValues.cbegin() + first, mValues.cbegin() + last,
+                std::back_inserter(measurements), [](const float value) { return !std::isnan(value); });
+        if (measurements.empty()) {
+            return std::nullopt;
+        }
+
+        // nearest rank
+        const auto rank = std::max<double>(1,
+                std::ceil(std::clamp(fraction, 0.0, 1.0) * measurements.size()));
+        const auto nth = measurements.begin() + static_cast<std::size_t>(rank) - 1;
+        std::nth_element(measurements.begin(), nth, measurements.end());
+        return *nth;
+    }
+
+    // whole months within the range, [firstMonth, lastMonth)
+    const auto firstMonth = static_cast<std::size_t>(
+            std::lower_bound(mMonthStarts.cbegin(), mMonthStarts.cend(), first) - mMonthStarts.cbegin());
+    const auto lastMonth = static_cast<std::size_t>(
+            std::upper_bound(mMonthStarts.cbegin(), mMonthStarts.cend(), last) - mMonthStarts.cbegin()) - 1;
+
+    QuantileSketch sketch;
+    if (firstMonth < lastMonth) {
+        addValues(sketch, mValues, first, mMonthStarts[firstMonth]);
+        for (auto month = firstMonth; month < lastMonth; ++month) {
+            sketch.merge(mMonthSketches[month]);
+        }
+        addValues(sketch, mValues, mMonthStarts[lastMonth], last);
+    } else {
+        addValues(sketch, mValues, first, last);
+    }
+
+    return sketch.quantile(fraction);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file quantile_sketch.cpp
+ * @date 10/16/2026
+ *
+ * @brief QuantileSketch class definition
+ */
+
+#include "data/quantile_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+QuantileSketch::QuantileSketch(const std::size_t k) :
+    mK(std::max<std::size_t>(k, 8)),
+    mLevels(1) {}
+
+void QuantileSketch::add(const float value) {
+    mLevels.front().push_back(value);
+    ++mCount;
+    ++mSize;
+    compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (mLevels.size() < other.mLevels.size()) {
+        mLevels.resize(other.mLevels.size());
+    }
+    for (std::size_t level = 0; level < other.mLevels.size(); ++level) {
+        mLevels[level].insert(mLevels[level].end(),
+                other.mLevels[level].cbegin(), other.mLevels[level].cend());
+    }
+    mCount += other.mCount;
+    mSize += other.mSize;
+    compress();
+}
+
+std::size_t QuantileSketch::count() const {
+    return mCount;
+}
+
+std::optional<float> QuantileSketch::quantile(const double fraction) const {
+    if (mCount == 0) {
+        return std::nullopt;
+    }
+
+    std::vector<std::pair<float, std::size_t>> weighted;
+    weighted.reserve(mSize);
+    for (std::size_t level = 0; level < mLevels.size(); ++level) {
+        for (const auto value : mLevels[level]) {
+            weighted.emplace_back(value, std::size_t{1} << level);
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    // nearest rank, the same definition as an exact quantile
+    const auto rank = std::max<double>(1, std::ceil(std::clamp(fraction, 0.0, 1.0) * mCount));
+    std::size_t cumulative = 0;
+    for (const auto& [value, weight] : weighted) {
+        cumulative += weight;
+        if (cumulative >= rank) {
+            return value;
+        }
+    }
+    return weighted.back().first;
+}
+
+std::size_t QuantileSketch::capacity(const std::size_t level) const {
+    const auto depth = mLevels.size() - 1 - level;
+    return std::max<std::size_t>(2,
+            static_cast<std::size_t>(std::ceil(mK * std::pow(2.0 / 3.0, depth))));
+}
+
+void QuantileSketch::compress() {
+    while (true) {
+        std::size_t totalCapacity = 0;
+        for (std::size_t level = 0; level < mLevels.size(); ++level) {
+            totalCapacity += capacity(level);
+        }
+        if (mSize <= totalCapacity) {
+            return;
+        }
+
+        // compact the lowest level that is over its capacity
+        std::size_t level = 0;
+        while (mLevels[level].size() < capacity(level)) {
+            ++level;
+        }
+        if (level + 1 == mLevels.size()) {
+            mLevels.emplace_back();
+        }
+
+        auto& values = mLevels[level];
+        std::sort(values.begin(), values.end());
+        // an odd value out stays at this level, so the total weight is unchanged
+        const auto keepOdd = values.size() % 2;
+        const auto offset = mCompactions++ % 2;
+        auto& next = mLevels[level + 1];
+        for (auto i = keepOdd + offset; i < values.size(); i += 2) {
+            next.push_back(values[i]);
+        }
+        mSize -= (values.size() - keepOdd) / 2;
+        values.resize(keepOdd);
+    }
+}
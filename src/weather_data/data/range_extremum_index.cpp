@@ -0,0 +1,86 @@
+/**
+ * @file range_extremum_index.cpp
+ * @date 10/16/2026
+ *
+ * @brief RangeExtremumIndex class definition
+ */
+
+#include "data/range_extremum_index.h"
+
+#include <cmath>
+#include <utility>
+
+namespace {
+    /** @brief floor(log2(n)) for n > 0 */
+    std::size_t floorLog2(std::size_t n) {
+        std::size_t log = 0;
+        while (n >>= 1) {
+            ++log;
+        }
+        return log;
+    }
+}
+
+RangeExtremumIndex::RangeExtremumIndex(
+        std::shared_ptr<const WeatherColumns> columns,
+        const WeatherData::Variable variable,
+        const Extremum extremum) :
+    mColumns(std::move(columns)),
+    mValues(mColumns->values(variable)),
+    mExtremum(extremum) {
+
+    if (mValues.empty()) {
+        return;
+    }
+
+    const auto levels = floorLog2(mValues.size()) + 1;
+    mTable.resize(levels);
+    mTable[0].resize(mValues.size());
+    for (std::size_t i = 0; i < mValues.size(); ++i) {
+        mTable[0][i] = static_cast<std::uint32_t>(i);
+    }
+
+    for (std::size_t k = 1; k < levels; ++k) {
+        const std::size_t half = std::size_t{1} << (k - 1);
+        const auto& previous = mTable[k - 1];
+        auto& level = mTable[k];
+        level.resize(mValues.size() - (half << 1) + 1);
+        for (std::size_t i = 0; i < level.size(); ++i) {
+            level[i] = better(previous[i], previous[i + half]);
+        }
+    }
+}
+
+std::optional<std::size_t> RangeExtremumIndex::query(
+        const std::size_t first,
+        const std::size_t last) const {
+    if (first >= last || last > mValues.size()) {
+        return std::nullopt;
+    }
+
+    // two ranges of length 2^k that together cover [first, last)
+    const auto k = floorLog2(last - first);
+    const auto position = better(mTable[k][first], mTable[k][last - (std::size_t{1} << k)]);
+    if (std::isnan(mValues[position])) {
+        return std::nullopt; // every value within the range is missing
+    }
+
+    return position;
+}
+
+std::uint32_t RangeExtremumIndex::better(const std::uint32_t lhs, const std::uint32_t rhs) const {
+    const auto lhsValue = mValues[lhs];
+    const auto rhsValue = mValues[rhs];
+    if (std::isnan(rhsValue)) {
+        return lhs;
+    } else if (std::isnan(lhsValue)) {
+        return rhs;
+    }
+
+    // prefer the earlier position when tied
+    const bool rhsBetter = (mExtremum == Extremum::Max) ? rhsValue > lhsValue : rhsValue < lhsValue;
+    if (rhsBetter || (rhsValue == lhsValue && rhs < lhs)) {
+        return rhs;
+    }
+    return lhs;
+}
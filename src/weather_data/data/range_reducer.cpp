@@ -0,0 +1,70 @@
+/**
+ * @file range_reducer.cpp
+ * @date 10/16/2026
+ *
+ * @brief RangeReducer class definition
+ */
+
+#include "data/range_reducer.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+    /** @brief Summarize the values of [first, last) in order */
+    VariableSummary reduceBlock(
+            const std::vector<float>& values,
+            const std::size_t first,
+            const std::size_t last) {
+        VariableSummary summary;
+        for (auto i = first; i < last; ++i) {
+            if (!std::isnan(values[i])) {
+                summary.add(values[i]);
+            }
+        }
+        return summary;
+    }
+}
+
+RangeReducer::RangeReducer(const std::size_t thread_count) :
+    mThreadCount(std::max<std::size_t>(thread_count, 1)) {}
+
+VariableSummary RangeReducer::reduce(
+        const std::vector<float>& values,
+        const std::size_t first,
+        const std::size_t last) const {
+    if (first >= last) {
+        return VariableSummary();
+    }
+
+    const auto blockCount = (last - first + BlockSize - 1) / BlockSize;
+    std::vector<VariableSummary> blocks(blockCount);
+    const auto reduceBlocks = [&](std::atomic<std::size_t>& nextBlock) {
+        for (auto block = nextBlock++; block < blockCount; block = nextBlock++) {
+            const auto blockFirst = first + block * BlockSize;
+            blocks[block] = reduceBlock(values, blockFirst, std::min(blockFirst + BlockSize, last));
+        }
+    };
+
+    std::atomic<std::size_t> nextBlock {0};
+    const auto threadCount = std::min(mThreadCount, blockCount);
+    if (threadCount == 1) {
+        reduceBlocks(nextBlock);
+    } else {
+        ThreadPool pool(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            pool.submit([&]() { reduceBlocks(nextBlock); });
+        }
+    } // pool waits for all blocks to be reduced
+
+    // merge neighbouring pairs until one summary is left, the order only depends on blockCount
+    for (std::size_t stride = 1; stride < blockCount; stride *= 2) {
+        for (std::size_t i = 0; i + stride < blockCount; i += 2 * stride) {
+            blocks[i].merge(blocks[i + stride]);
+        }
+    }
+
+    return blocks.front();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file rolling_window.cpp
+ * @date 10/16/2026
+ *
+ * @brief RollingWindow class definition
+ */
+
+#include "data/rolling_window.h"
+
+#include <cmath>
+#include <deque>
+
+RollingWindow::RollingWindow(
+        const WeatherColumns& columns,
+        const WeatherData::Variable variable,
+        const WeatherData::data_time window_sec) :
+    mColumns(columns),
+    mVariable(variable),
+    mWindowSec(window_sec) {}
+
+std::size_t RollingWindow::slide(
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const std::function<void(WeatherData::data_time, const VariableSummary&)>& visitor) const {
+    const auto range = mColumns.range(begin_sec, end_sec);
+    if (range.first == range.second || mWindowSec <= 0) {
+        return 0;
+    }
+
+    const auto& times = mColumns.times();
+    const auto& values = mColumns.values(mVariable);
+
+    // the window of the first data point may begin before the range
+    auto first = mColumns.range(times[range.first] - mWindowSec + 1, times[range.first]).first;
+    auto last = first;
+
+    std::size_t count = 0;
+    double sum = 0;
+    // positions of measurements within the window, whose values increase (min) or decrease (max)
+    std::deque<std::size_t> minQueue;
+    std::deque<std::size_t> maxQueue;
+
+    for (auto position = range.first; position < range.second; ++position) {
+        const auto time = times[position];
+
+        // add measurements up to and including the current data point
+        for (; last <= position; ++last) {
+            const auto value = values[last];
+            if (std::isnan(value)) {
+                continue;
+            }
+            ++count;
+            sum += value;
+            while (!minQueue.empty() && values[minQueue.back()] > value) {
+                minQueue.pop_back();
+            }
+            minQueue.push_back(last);
+            while (!maxQueue.empty() && values[maxQueue.back()] < value) {
+                maxQueue.pop_back();
+            }
+            maxQueue.push_back(last);
+        }
+
+        // remove measurements that are older than the window
+        for (; times[first] <= time - mWindowSec; ++first) {
+            const auto value = values[first];
+            if (std::isnan(value)) {
+                continue;
+            }
+            --count;
+            sum -= value;
+            if (minQueue.front() == first) {
+                minQueue.pop_front();
+            }
+            if (maxQueue.front() == first) {
+                maxQueue.pop_front();
+            }
+        }
+        if (count == 0) {
+            sum = 0; // drop any rounding error left by the running sum
+        }
+
+        VariableSummary summary;
+        if (count > 0) {
+            summary.count = count;
+            summary.sum = sum;
+            summary.min = values[minQueue.front()];
+            summary.max = values[maxQueue.front()];
+        }
+        visitor(time, summary);
+    }
+
+    return range.second - range.first;
+}
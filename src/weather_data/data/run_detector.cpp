@@ -0,0 +1,115 @@
+/**
+ * @file run_detector.cpp
+ * @date 10/16/2026
+ *
+ * @brief RunDetector class definition
+ */
+
+#include "data/run_detector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+namespace {
+    /**
+     * @brief Evaluate a condition for each value of [first, last). The comparison is a
+     * template parameter and the pointers are restrict qualified (matches never aliases
+     * values), so GCC and Clang vectorize the loop at -O3.
+     */
+    template <typename Compare>
+    void evaluate(const std::vector<float>& values,
+            const std::size_t first,
+            const std::size_t last,
+            const float threshold,
+            std::vector<std::uint8_t>& matches,
+            Compare compare) {
+        const float* __restrict source = values.data() + first;
+        std::uint8_t* __restrict destination = matches.data();
+        const auto count = last - first;
+        for (std::size_t i = 0; i < count; ++i) {
+            destination[i] = compare(source[i], threshold) ? 1 : 0;
+        }
+    }
+}
+
+RunDetector::RunDetector(const WeatherColumns& columns) :
+    mColumns(columns) {}
+
+std::vector<RunDetector::Run> RunDetector::detect(
+        const WeatherData::Variable variable,
+        const ValueBitmapIndex::Comparison comparison,
+        const float threshold,
+        const std::size_t min_length,
+        const std::size_t first,
+        const std::size_t last) const {
+    std::vector<Run> runs;
+    if (first >= last) {
+        return runs;
+    }
+
+    const auto& times = mColumns.times();
+    const auto& values = mColumns.values(variable);
+
+    // evaluate the condition of every data point in a single pass,
+    // NaN never compares true so missing measurements never match
+    std::vector<std::uint8_t> matches(last - first);
+    switch (comparison) {
+    case ValueBitmapIndex::Comparison::Less:
+        evaluate(values, first, last, threshold, matches, std::less<float>());
+        break;
+    case ValueBitmapIndex::Comparison::LessEqual:
+        evaluate(values, first, last, threshold, matches, std::less_equal<float>());
+        break;
+    case ValueBitmapIndex::Comparison::Equal:
+        evaluate(values, first, last, threshold, matches, std::equal_to<float>());
+        break;
+    case ValueBitmapIndex::Comparison::GreaterEqual:
+        evaluate(values, first, last, threshold, matches, std::greater_equal<float>());
+        break;
+    case ValueBitmapIndex::Comparison::Greater:
+        evaluate(values, first, last, threshold, matches, std::greater<float>());
+        break;
+    }
+
+    const bool peakIsMin = comparison == ValueBitmapIndex::Comparison::Less
+        || comparison == ValueBitmapIndex::Comparison::LessEqual;
+    const auto finishRun = [&](const Run& run) {
+        if (run.length >= std::max<std::size_t>(min_length, 1)) {
+            runs.push_back(run);
+        }
+    };
+
+    Run run {0, 0, 0, 0};
+    for (auto i = first; i < last; ++i) {
+        if (!matches[i - first]) {
+            if (run.length > 0) {
+                finishRun(run);
+                run.length = 0;
+            }
+            continue;
+        }
+
+        // a missing day between two matching days ends the run
+        if (run.length > 0 && WeatherData::dayNumber(times[i]) != WeatherData::dayNumber(times[run.last]) + 1) {
+            finishRun(run);
+            run.length = 0;
+        }
+
+        if (run.length == 0) {
+            run = Run{i, i, 1, i};
+        } else {
+            run.last = i;
+            ++run.length;
+            if (peakIsMin ? values[i] < values[run.peak] : values[i] > values[run.peak]) {
+                run.peak = i;
+            }
+        }
+    }
+    if (run.length > 0) {
+        finishRun(run);
+    }
+
+    return runs;
+}
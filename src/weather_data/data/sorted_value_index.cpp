@@ -0,0 +1,73 @@
+/**
+ * @file sorted_value_index.cpp
+ * @date 10/16/2026
+ *
+ * @brief SortedValueIndex class definition
+ */
+
+#include "data/sorted_value_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+SortedValueIndex::SortedValueIndex(
+        std::shared_ptr<const WeatherColumns> columns,
+        const WeatherData::Variable variable,
+        const RangeExtremumIndex::Extremum extremum) :
+    mColumns(std::move(columns)),
+    mValues(mColumns->values(variable)),
+    mExtremum(extremum) {
+    mSorted.reserve(mValues.size());
+    for (std::size_t i = 0; i < mValues.size(); ++i) {
+        if (!std::isnan(mValues[i])) {
+            mSorted.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    std::sort(mSorted.begin(), mSorted.end(),
+            [this](const std::uint32_t lhs, const std::uint32_t rhs) { return before(lhs, rhs); });
+}
+
+std::vector<std::size_t> SortedValueIndex::top(
+        const std::size_t k,
+        const std::size_t first,
+        const std::size_t last) const {
+    std::vector<std::size_t> positions;
+    if (k == 0 || first >= last) {
+        return positions;
+    }
+
+    // walking the sorted positions visits about k * size / rangeSize positions,
+    // partially sorting the range visits rangeSize positions
+    const auto rangeSize = last - first;
+    if (rangeSize * rangeSize >= k * mValues.size()) {
+        for (const auto position : mSorted) {
+            if (position >= first && position < last) {
+                positions.push_back(position);
+                if (positions.size() == k) {
+                    break;
+                }
+            }
+        }
+        return positions;
+    }
+
+    for (auto i = first; i < last; ++i) {
+        if (!std::isnan(mValues[i])) {
+            positions.push_back(i);
+        }
+    }
+    const auto middle = positions.begin() + std::min(k, positions.size());
+    std::partial_sort(positions.begin(), middle, positions.end(),
+            [this](const std::size_t lhs, const std::size_t rhs) { return before(lhs, rhs); });
+    positions.erase(middle, positions.end());
+    return positions;
+}
+
+bool SortedValueIndex::before(const std::size_t lhs, const std::size_t rhs) const {
+    if (mValues[lhs] != mValues[rhs]) {
+        return (mExtremum == RangeExtremumIndex::Extremum::Max) ?
+            mValues[lhs] > mValues[rhs] : mValues[lhs] < mValues[rhs];
+    }
+    return lhs < rhs;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file value_bitmap_index.cpp
+ * @date 10/16/2026
+ *
+ * @brief ValueBitmapIndex class definition
+ */
+
+#include "data/value_bitmap_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+ValueBitmapIndex::ValueBitmapIndex(
+        std::shared_ptr<const WeatherColumns> columns,
+        const WeatherData::Variable variable) :
+    mColumns(std::move(columns)),
+    mValues(mColumns->values(variable)) {
+    std::vector<float> sorted;
+    sorted.reserve(mValues.size());
+    std::copy_if(mValues.cbegin(), mValues.cend(), std::back_inserter(sorted),
+            [](const float value) { return !std::isnan(value); });
+    std::sort(sorted.begin(), sorted.end());
+
+    // bins of about equal size, a value repeated many times (ex. 0 ppt) gets its own bin
+    for (std::size_t bin = 0; bin < BinCount && !sorted.empty(); ++bin) {
+        const auto boundary = sorted[bin * sorted.size() / BinCount];
+        if (mBoundaries.empty() || mBoundaries.back() < boundary) {
+            mBoundaries.push_back(boundary);
+        }
+    }
+
+    mBins.resize(mBoundaries.size());
+    mAtLeast.resize(mBoundaries.size() + 1);
+    for (std::size_t i = 0; i < mValues.size(); ++i) {
+        if (std::isnan(mValues[i])) {
+            continue;
+        }
+        const auto bin = static_cast<std::size_t>(
+                std::upper_bound(mBoundaries.cbegin(), mBoundaries.cend(), mValues[i])
+                - mBoundaries.cbegin()) - 1;
+        mBins[bin].append(static_cast<std::uint32_t>(i));
+        for (std::size_t boundary = 0; boundary <= bin; ++boundary) {
+            mAtLeast[boundary].append(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+std::size_t ValueBitmapIndex::count(const Comparison comparison,
+        const float threshold,
+        const std::size_t first,
+        const std::size_t last) const {
+    if (first >= last) {
+        return 0;
+    }
+
+    const auto first32 = static_cast<std::uint32_t>(first);
+    const auto last32 = static_cast<std::uint32_t>(last);
+    const auto queryPlan = plan(comparison, threshold);
+
+    // values of bins [firstBin, lastBin) are those at or above firstBin, but not lastBin
+    std::size_t total = 0;
+    if (queryPlan.firstBin < queryPlan.lastBin) {
+        total = mAtLeast[queryPlan.firstBin].count(first32, last32)
+            - mAtLeast[queryPlan.lastBin].count(first32, last32);
+    }
+
+    if (queryPlan.partialBin < mBins.size()) {
+        mBins[queryPlan.partialBin].forEach(first32, last32, [&](const std::uint32_t position) {
+                if (matches(comparison, mValues[position], threshold)) {
+                    ++total;
+                }
+            });
+    }
+    return total;
+}
+
+std::vector<std::size_t> ValueBitmapIndex::find(const Comparison comparison,
+        const float threshold,
+        const std::size_t first,
+        const std::size_t last) const {
+    std::vector<std::size_t> positions;
+    if (first >= last) {
+        return positions;
+    }
+
+    const auto first32 = static_cast<std::uint32_t>(first);
+    const auto last32 = static_cast<std::uint32_t>(last);
+    const auto queryPlan = plan(comparison, threshold);
+
+    for (auto bin = queryPlan.firstBin; bin < queryPlan.lastBin; ++bin) {
+        mBins[bin].forEach(first32, last32, [&](const std::uint32_t position) {
+                positions.push_back(position);
+            });
+    }
+
+    if (queryPlan.partialBin < mBins.size()) {
+        mBins[queryPlan.partialBin].forEach(first32, last32, [&](const std::uint32_t position) {
+                if (matches(comparison, mValues[position], threshold)) {
+                    positions.push_back(position);
+                }
+            });
+    }
+
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
+ValueBitmapIndex::Plan ValueBitmapIndex::plan(const Comparison comparison, const float threshold) const {
+    const auto binCount = mBoundaries.size();
+    Plan queryPlan;
+    if (binCount == 0 || std::isnan(threshold)) {
+        return queryPlan;
+    }
+
+    // the bin containing the threshold, or none if the threshold is below every value
+    const auto thresholdBin = static_cast<std::size_t>(
+            std::upper_bound(mBoundaries.cbegin(), mBoundaries.cend(), threshold)
+            - mBoundaries.cbegin());
+    if (thresholdBin == 0) {
+        if (comparison == Comparison::Greater || comparison == Comparison::GreaterEqual) {
+            queryPlan.lastBin = binCount;
+        }
+        return queryPlan;
+    }
+
+    queryPlan.partialBin = thresholdBin - 1;
+    switch (comparison) {
+    case Comparison::Less:
+    case Comparison::LessEqual:
+        queryPlan.firstBin = 0;
+        queryPlan.lastBin = thresholdBin - 1;
+        break;
+    case Comparison::Greater:
+    case Comparison::GreaterEqual:
+        queryPlan.firstBin = thresholdBin;
+        queryPlan.lastBin = binCount;
+        break;
+    case Comparison::Equal:
+        break;
+    }
+    return queryPlan;
+}
+
+bool ValueBitmapIndex::matches(const Comparison comparison, const float value, const float threshold) {
+    switch (comparison) {
+    case Comparison::Less:
+        return value < threshold;
+    case Comparison::LessEqual:
+        return value <= threshold;
+    case Comparison::Equal:
+        return value == threshold;
+    case Comparison::GreaterEqual:
+        return value >= threshold;
+    case Comparison::Greater:
+        return value > threshold;
+    }
+    return false;
+}
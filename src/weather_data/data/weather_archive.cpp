@@ -6,18 +6,203 @@
  */
 
 #include "data/weather_archive.h"
+#include "thread_pool.h"
+
+#include "date/date.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <future>
+#include <iterator>
+
+namespace {
+    /** @brief Order weather data by time, all data must have its time set */
+    bool earlierTime(const WeatherData& lhs, const WeatherData& rhs) {
+        return lhs.time.value() < rhs.time.value();
+    }
+
+    /**
+     * @brief Get an index from the cache, building and caching it if it is not present
+     * @param[in] cached The cached index, accessed atomically
+     * @param[out] built Set when an index is built, so clearing the cache is not skipped
+     * @param[in] build Function that builds the index
+     * @return The index
+     */
+    template <typename Index, typename Build>
+    std::shared_ptr<const Index> loadOrBuild(
+            std::shared_ptr<const Index>& cached,
+            std::atomic<bool>& built,
+            Build build) {
+        auto index = std::atomic_load(&cached);
+        if (!index) {
+            // concurrent readers may build the same index, either result is correct
+            built.store(true);
+            index = build();
+            std::atomic_store(&cached, index);
+        }
+        return index;
+    }
+
+    /**
+     * @brief Get an index cached per query parameter, building and caching it if it is
+     * not present. The lock is not held while building. The cached indexes are cleared
+     * first if there are already limit of them.
+     * @param[in] cached The cached indexes, keyed by query parameter
+     * @param[in] mutex Guards cached
+     * @param[out] built Set when an index is built, so clearing the cache is not skipped
+     * @param[in] key The query parameter
+     * @param[in] build Function that builds the index
+     * @param[in] limit Maximum number of cached indexes
+     * @return The index
+     */
+    template <typename Key, typename Index, typename Build>
+    std::shared_ptr<const Index> loadOrBuildKeyed(
+            std::map<Key, std::shared_ptr<const Index>>& cached,
+            std::mutex& mutex,
+            std::atomic<bool>& built,
+            const Key& key,
+            Build build,
+            const std::size_t limit) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto it = cached.find(key);
+            if (it != cached.end()) {
+                return it->second;
+            }
+        }
+
+        // concurrent readers may build the same index, the first one cached is kept
+        built.store(true);
+        auto index = build();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cached.size() >= limit && cached.find(key) == cached.end()) {
+            cached.clear();
+        }
+        return cached.emplace(key, std::move(index)).first->second;
+    }
+}
+
+void WeatherArchive::IndexCache::clear() {
+    // data is added far more often than indexes are built, so only clear what was built
+    if (!built.exchange(false)) {
+        return;
+    }
+
+    std::atomic_store(&columns, std::shared_ptr<const WeatherColumns>());
+    std::atomic_store(&temperatures, std::shared_ptr<const DegreeDayIndex::Temperatures>());
+    for (auto& extremum : extremums) {
+        std::atomic_store(&extremum, std::shared_ptr<const RangeExtremumIndex>());
+    }
+    for (auto& quantile : quantiles) {
+        std::atomic_store(&quantile, std::shared_ptr<const QuantileIndex>());
+    }
+    for (auto& bitmap : bitmaps) {
+        std::atomic_store(&bitmap, std::shared_ptr<const ValueBitmapIndex>());
+    }
+    for (auto& sorted : sortedValues) {
+        std::atomic_store(&sorted, std::shared_ptr<const SortedValueIndex>());
+    }
+
+    std::lock_guard<std::mutex> lock(keyedMutex);
+    normals.clear();
+    degreeDays.clear();
+    samplers.clear();
+}
 
 void WeatherArchive::addData(const WeatherData& data) {
-    if (data.time.has_value()) {
-        mWeatherMap[data.time.value()] = data;
+    if (!data.time.has_value()) {
+        return;
+    }
+    mIndexCache.clear();
+
+    // data is usually added in time order, so appending is the fast path
+    if (mWeatherData.empty() || mWeatherData.back().time.value() < data.time.value()) {
+        mWeatherData.push_back(data);
+        mRollup.add(data);
+        return;
+    }
+
+    const auto it = lowerBound(data.time.value());
+    if (it != mWeatherData.end() && it->time.value() == data.time.value()) {
+        mWeatherData[std::distance(mWeatherData.cbegin(), it)] = data;
+        mRollup.rebuildMonth(data.time.value(), mWeatherData);
+    } else {
+        mWeatherData.insert(it, data);
+        mRollup.add(data);
+    }
+}
+
+void WeatherArchive::addBatch(std::vector<WeatherData>&& data) {
+    data.erase(std::remove_if(data.begin(), data.end(),
+                [](const WeatherData& weatherData) { return !weatherData.time.has_value(); }),
+            data.end());
+
+    if (data.empty()) {
+        return;
+    }
+    mIndexCache.clear();
+
+    const auto isStrictlySorted = std::adjacent_find(data.cbegin(), data.cend(),
+            [](const WeatherData& lhs, const WeatherData& rhs) {
+                return !earlierTime(lhs, rhs);
+            }) == data.cend();
+
+    if (!isStrictlySorted) {
+        // stable sort keeps duplicates in input order, then keep the last of each
+        // duplicate by removing duplicates from the reversed range
+        std::stable_sort(data.begin(), data.end(), earlierTime);
+        const auto uniqueEnd = std::unique(data.rbegin(), data.rend(),
+                [](const WeatherData& lhs, const WeatherData& rhs) {
+                    return lhs.time.value() == rhs.time.value();
+                });
+        data.erase(data.begin(), uniqueEnd.base());
     }
+
+    if (mWeatherData.empty() || earlierTime(mWeatherData.back(), data.front())) {
+        for (const auto& weatherData : data) {
+            mRollup.add(weatherData);
+        }
+        if (mWeatherData.empty()) {
+            mWeatherData = std::move(data);
+        } else {
+            mWeatherData.reserve(mWeatherData.size() + data.size());
+            std::move(data.begin(), data.end(), std::back_inserter(mWeatherData));
+        }
+    } else {
+        // merge the two sorted vectors, data from the batch replaces archive data
+        std::vector<WeatherData> merged;
+        merged.reserve(mWeatherData.size() + data.size());
+        auto archiveIt = mWeatherData.begin();
+        auto batchIt = data.begin();
+        while (archiveIt != mWeatherData.end() && batchIt != data.end()) {
+            if (earlierTime(*archiveIt, *batchIt)) {
+                merged.push_back(std::move(*archiveIt++));
+            } else {
+                if (!earlierTime(*batchIt, *archiveIt)) {
+                    ++archiveIt; // same time, replaced by the batch
+                }
+                merged.push_back(std::move(*batchIt++));
+            }
+        }
+        std::move(archiveIt, mWeatherData.end(), std::back_inserter(merged));
+        std::move(batchIt, data.end(), std::back_inserter(merged));
+        mWeatherData = std::move(merged);
+
+        // data may have been replaced, which a summary cannot subtract
+        mRollup = WeatherRollup(mWeatherData);
+    }
+}
+
+std::size_t WeatherArchive::size() const {
+    return mWeatherData.size();
 }
 
 std::optional<WeatherData> WeatherArchive::retrieve(
         const WeatherData::data_time time) const {
-    const auto it = mWeatherMap.find(time);
-    if (it != mWeatherMap.end()) {
-        return it->second;
+    const auto it = lowerBound(time);
+    if (it != mWeatherData.end() && it->time.value() == time) {
+        return *it;
     } else {
         return std::nullopt;
     }
@@ -29,23 +214,309 @@ std::vector<WeatherData> WeatherArchive::retrieveRange(
 
     // the beginning of the range must be before the end of the range
     if (begin_sec <= end_sec) {
-        const auto begin_it = mWeatherMap.find(begin_sec);
-        // at least the beginning of the range needs to be present
-        if (begin_it != mWeatherMap.end()) {
-            const auto end_it = mWeatherMap.find(end_sec);
-            // regardless if end_sec is within the map or not
-            // (aka end_it = map.end()) this is valid
-            std::vector<WeatherData> retData;
-            retData.reserve(std::distance(begin_it, end_it));
-            for (auto it = begin_it; it != mWeatherMap.end(); ++it) {
-                retData.push_back(it->second);
-                if (it == end_it) {
-                    break;
+        const auto beginIt = lowerBound(begin_sec);
+        const auto endIt = std::upper_bound(beginIt, mWeatherData.cend(), end_sec,
+                [](const WeatherData::data_time time, const WeatherData& data) {
+                    return time < data.time.value();
+                });
+        return {beginIt, endIt};
+    }
+
+    return {};
+}
+
+std::optional<WeatherData> WeatherArchive::retrieveMax(
+        const WeatherData::Variable variable,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    return retrieveExtremum(variable, RangeExtremumIndex::Extremum::Max, begin_sec, end_sec);
+}
+
+std::optional<WeatherData> WeatherArchive::retrieveMin(
+        const WeatherData::Variable variable,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    return retrieveExtremum(variable, RangeExtremumIndex::Extremum::Min, begin_sec, end_sec);
+}
+
+std::size_t WeatherArchive::countWhere(
+        const WeatherData::Variable variable,
+        const ValueBitmapIndex::Comparison comparison,
+        const float threshold,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    const auto index = bitmapIndex(variable);
+    const auto range = columns()->range(begin_sec, end_sec);
+    return index->count(comparison, threshold, range.first, range.second);
+}
+
+std::vector<WeatherData> WeatherArchive::retrieveWhere(
+        const WeatherData::Variable variable,
+        const ValueBitmapIndex::Comparison comparison,
+        const float threshold,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    const auto index = bitmapIndex(variable);
+    const auto range = columns()->range(begin_sec, end_sec);
+
+    std::vector<WeatherData> matches;
+    for (const auto position : index->find(comparison, threshold, range.first, range.second)) {
+        matches.push_back(mWeatherData[position]);
+    }
+    return matches;
+}
+
+std::size_t WeatherArchive::retrieveRuns(
+        const WeatherData::Variable variable,
+        const ValueBitmapIndex::Comparison comparison,
+        const float threshold,
+        const std::size_t min_days,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const std::function<void(const WeatherData& first, const WeatherData& last,
+            const WeatherData& peak, std::size_t length)>& visitor) const {
+    const auto weatherColumns = columns();
+    const auto range = weatherColumns->range(begin_sec, end_sec);
+    const auto runs = RunDetector(*weatherColumns).detect(
+            variable, comparison, threshold, min_days, range.first, range.second);
+    for (const auto& run : runs) {
+        visitor(mWeatherData[run.first], mWeatherData[run.last], mWeatherData[run.peak], run.length);
+    }
+    return runs.size();
+}
+
+std::optional<float> WeatherArchive::retrievePercentile(
+        const WeatherData::Variable variable,
+        const double percentile,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    const auto weatherColumns = columns();
+    const auto index = loadOrBuild(mIndexCache.quantiles[static_cast<std::size_t>(variable)],
+            mIndexCache.built, [&]() {
+            return std::make_shared<const QuantileIndex>(weatherColumns, variable);
+        });
+
+    const auto range = weatherColumns->range(begin_sec, end_sec);
+    return index->query(range.first, range.second, percentile / 100.0);
+}
+
+DegreeDayIndex::DegreeDays WeatherArchive::retrieveDegreeDays(
+        const float base,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    const auto weatherColumns = columns();
+    const auto index = loadOrBuildKeyed(mIndexCache.degreeDays, mIndexCache.keyedMutex,
+            mIndexCache.built, base, [&]() {
+            const auto temperatures = loadOrBuild(mIndexCache.temperatures, mIndexCache.built, [&]() {
+                    return std::make_shared<const DegreeDayIndex::Temperatures>(*weatherColumns);
+                });
+            return std::make_shared<const DegreeDayIndex>(temperatures, base);
+        }, IndexCache::KeyedLimit);
+
+    const auto range = weatherColumns->range(begin_sec, end_sec);
+    return index->query(range.first, range.second);
+}
+
+std::vector<WeatherData> WeatherArchive::sampleHistory(
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const int first_year,
+        const int last_year,
+        const std::uint64_t seed,
+        const std::size_t thread_count,
+        const std::uint64_t member,
+        const std::size_t block_length,
+        const std::vector<double>& year_weights) const {
+    const auto firstDay = WeatherData::dayNumber(begin_sec);
+    const auto lastDay = WeatherData::dayNumber(end_sec);
+    if (firstDay > lastDay) {
+        return {};
+    }
+
+    const auto positions = sampler(first_year, last_year, year_weights)->sample(
+            CounterRandom(seed), firstDay, static_cast<std::size_t>(lastDay - firstDay + 1),
+            thread_count, member, block_length);
+
+    std::vector<WeatherData> sampled;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        if (positions[i] != HistoricalSampler::NoData) {
+            sampled.push_back(mWeatherData[positions[i]]);
+            sampled.back().time = (firstDay + static_cast<WeatherData::data_time>(i)) * WeatherData::DaySeconds;
+        }
+    }
+    return sampled;
+}
+
+std::vector<QuantileSketch> WeatherArchive::sampleBands(
+        const WeatherData::Variable variable,
+        const std::size_t member_count,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const int first_year,
+        const int last_year,
+        const std::uint64_t seed,
+        const std::size_t thread_count,
+        const std::size_t block_length,
+        const std::vector<double>& year_weights) const {
+    const auto firstDay = date::floor<date::days>(
+            date::sys_seconds{std::chrono::seconds{begin_sec}}).time_since_epoch().count();
+    const auto lastDay = date::floor<date::days>(
+            date::sys_seconds{std::chrono::seconds{end_sec}}).time_since_epoch().count();
+    if (firstDay > lastDay) {
+        return {};
+    }
+
+    const auto dayCount = static_cast<std::size_t>(lastDay - firstDay + 1);
+    const auto weatherColumns = columns();
+    const auto& values = weatherColumns->values(variable);
+    const auto historicalSampler = sampler(first_year, last_year, year_weights);
+    const CounterRandom random(seed);
+
+    // sketch the members of a group in member order
+    const auto sketchGroup = [&](const std::size_t group) {
+        std::vector<QuantileSketch> sketches(dayCount);
+        const auto groupLast = std::min((group + 1) * MembersPerGroup, member_count);
+        for (auto member = group * MembersPerGroup; member < groupLast; ++member) {
+            const auto positions = historicalSampler->sample(random, firstDay, dayCount, 1, member, block_length);
+            for (std::size_t day = 0; day < dayCount; ++day) {
+                if (positions[day] != HistoricalSampler::NoData && !std::isnan(values[positions[day]])) {
+                    sketches[day].add(values[positions[day]]);
                 }
             }
-            return retData;
+        }
+        return sketches;
+    };
+
+    // merge the groups in order as they finish, at most two groups per thread are pending
+    std::vector<QuantileSketch> bands(dayCount);
+    const auto groupCount = (member_count + MembersPerGroup - 1) / MembersPerGroup;
+    ThreadPool pool(std::max<std::size_t>(std::min(thread_count, groupCount), 1));
+    std::deque<std::future<std::vector<QuantileSketch>>> pending;
+    const auto mergeFront = [&]() {
+        const auto sketches = pending.front().get();
+        pending.pop_front();
+        for (std::size_t day = 0; day < dayCount; ++day) {
+            bands[day].merge(sketches[day]);
+        }
+    };
+    for (std::size_t group = 0; group < groupCount; ++group) {
+        pending.push_back(pool.submit([&, group]() { return sketchGroup(group); }));
+        if (pending.size() >= 2 * pool.size()) {
+            mergeFront();
         }
     }
+    while (!pending.empty()) {
+        mergeFront();
+    }
 
-    return {};
+    return bands;
+}
+
+std::shared_ptr<const HistoricalSampler> WeatherArchive::sampler(
+        const int first_year,
+        const int last_year,
+        const std::vector<double>& year_weights) const {
+    return loadOrBuildKeyed(mIndexCache.samplers, mIndexCache.keyedMutex, mIndexCache.built,
+            std::make_tuple(first_year, last_year, year_weights), [&]() {
+                return std::make_shared<const HistoricalSampler>(
+                        *columns(), first_year, last_year, year_weights);
+            }, IndexCache::KeyedLimit);
+}
+
+VariableSummary WeatherArchive::summarizeRange(
+        const WeatherData::Variable variable,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const std::size_t thread_count) const {
+    const auto weatherColumns = columns();
+    const auto range = weatherColumns->range(begin_sec, end_sec);
+    return RangeReducer(thread_count).reduce(
+            weatherColumns->values(variable), range.first, range.second);
+}
+
+std::size_t WeatherArchive::retrieveRolling(
+        const WeatherData::Variable variable,
+        const WeatherData::data_time window_sec,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const std::function<void(WeatherData::data_time, const VariableSummary&)>& visitor) const {
+    const auto weatherColumns = columns();
+    return RollingWindow(*weatherColumns, variable, window_sec).slide(begin_sec, end_sec, visitor);
+}
+
+std::vector<WeatherData> WeatherArchive::retrieveTop(
+        const WeatherData::Variable variable,
+        const std::size_t k,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const RangeExtremumIndex::Extremum extremum) const {
+    const auto weatherColumns = columns();
+    const auto slot = 2 * static_cast<std::size_t>(variable)
+        + (extremum == RangeExtremumIndex::Extremum::Max ? 1 : 0);
+    const auto index = loadOrBuild(mIndexCache.sortedValues[slot], mIndexCache.built, [&]() {
+            return std::make_shared<const SortedValueIndex>(weatherColumns, variable, extremum);
+        });
+
+    const auto range = weatherColumns->range(begin_sec, end_sec);
+    std::vector<WeatherData> topData;
+    for (const auto position : index->top(k, range.first, range.second)) {
+        topData.push_back(mWeatherData[position]);
+    }
+    return topData;
+}
+
+const WeatherRollup& WeatherArchive::rollup() const {
+    return mRollup;
+}
+
+std::shared_ptr<const WeatherColumns> WeatherArchive::columns() const {
+    return loadOrBuild(mIndexCache.columns, mIndexCache.built, [this]() {
+            return std::make_shared<const WeatherColumns>(mWeatherData);
+        });
+}
+
+std::shared_ptr<const ClimatologyNormals> WeatherArchive::normals(
+        const int first_year,
+        const int last_year) const {
+    return loadOrBuildKeyed(mIndexCache.normals, mIndexCache.keyedMutex, mIndexCache.built,
+            std::make_pair(first_year, last_year), [&]() {
+                return std::make_shared<const ClimatologyNormals>(*columns(), first_year, last_year);
+            }, IndexCache::KeyedLimit);
+}
+
+std::optional<WeatherData> WeatherArchive::retrieveExtremum(
+        const WeatherData::Variable variable,
+        const RangeExtremumIndex::Extremum extremum,
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    const auto weatherColumns = columns();
+    const auto slot = 2 * static_cast<std::size_t>(variable)
+        + (extremum == RangeExtremumIndex::Extremum::Max ? 1 : 0);
+    const auto index = loadOrBuild(mIndexCache.extremums[slot], mIndexCache.built, [&]() {
+            return std::make_shared<const RangeExtremumIndex>(weatherColumns, variable, extremum);
+        });
+
+    const auto range = weatherColumns->range(begin_sec, end_sec);
+    const auto position = index->query(range.first, range.second);
+    if (position.has_value()) {
+        return mWeatherData[position.value()];
+    } else {
+        return std::nullopt;
+    }
+}
+
+std::shared_ptr<const ValueBitmapIndex> WeatherArchive::bitmapIndex(
+        const WeatherData::Variable variable) const {
+    return loadOrBuild(mIndexCache.bitmaps[static_cast<std::size_t>(variable)],
+            mIndexCache.built, [&]() {
+            return std::make_shared<const ValueBitmapIndex>(columns(), variable);
+        });
+}
+
+std::vector<WeatherData>::const_iterator WeatherArchive::lowerBound(
+        const WeatherData::data_time time) const {
+    return std::lower_bound(mWeatherData.cbegin(), mWeatherData.cend(), time,
+            [](const WeatherData& data, const WeatherData::data_time time) {
+                return data.time.value() < time;
+            });
 }
@@ -0,0 +1,76 @@
+/**
+ * @file weather_columns.cpp
+ * @date 10/16/2026
+ *
+ * @brief WeatherColumns class definition
+ */
+
+#include "data/weather_columns.h"
+
+#include "date/date.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+    /** @brief Get the calendar month of a timestamp, as a count of months since year 0 */
+    int monthNumber(const WeatherData::data_time time) {
+        const date::year_month_day ymd{date::floor<date::days>(
+                date::sys_seconds{std::chrono::seconds{time}})};
+        return static_cast<int>(ymd.year()) * 12 + static_cast<int>(static_cast<unsigned>(ymd.month()));
+    }
+}
+
+WeatherColumns::WeatherColumns(const std::vector<WeatherData>& data) {
+    mTimes.reserve(data.size());
+    for (auto& column : mValues) {
+        column.reserve(data.size());
+    }
+
+    for (const auto& weatherData : data) {
+        mTimes.push_back(weatherData.time.value());
+        for (std::size_t v = 0; v < WeatherData::VariableCount; ++v) {
+            mValues[v].push_back(weatherData.value(static_cast<WeatherData::Variable>(v))
+                    .value_or(std::numeric_limits<float>::quiet_NaN()));
+        }
+    }
+}
+
+std::size_t WeatherColumns::size() const {
+    return mTimes.size();
+}
+
+const std::vector<WeatherData::data_time>& WeatherColumns::times() const {
+    return mTimes;
+}
+
+const std::vector<float>& WeatherColumns::values(const WeatherData::Variable variable) const {
+    return mValues[static_cast<std::size_t>(variable)];
+}
+
+std::pair<std::size_t, std::size_t> WeatherColumns::range(
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    if (begin_sec > end_sec) {
+        return {0, 0};
+    }
+
+    const auto first = std::lower_bound(mTimes.cbegin(), mTimes.cend(), begin_sec);
+    const auto last = std::upper_bound(first, mTimes.cend(), end_sec);
+    return {static_cast<std::size_t>(first - mTimes.cbegin()),
+        static_cast<std::size_t>(last - mTimes.cbegin())};
+}
+
+std::vector<std::size_t> WeatherColumns::monthStarts() const {
+    std::vector<std::size_t> starts;
+    int previousMonth = 0;
+    for (std::size_t i = 0; i < mTimes.size(); ++i) {
+        const auto month = monthNumber(mTimes[i]);
+        if (i == 0 || month != previousMonth) {
+            starts.push_back(i);
+            previousMonth = month;
+        }
+    }
+    starts.push_back(mTimes.size());
+    return starts;
+}
@@ -47,3 +47,22 @@ bool WeatherData::operator== (const WeatherData& other) const {
         && minTemp == other.minTemp && meanTemp == other.meanTemp
         && gas_ppt == other.gas_ppt;
 }
+
+const std::optional<float>& WeatherData::value(const Variable variable) const {
+    switch (variable) {
+        case Variable::MaxTemp:
+            return maxTemp;
+        case Variable::MinTemp:
+            return minTemp;
+        case Variable::MeanTemp:
+            return meanTemp;
+        case Variable::GasPpt:
+        default:
+            return gas_ppt;
+    }
+}
+
+std::optional<float>& WeatherData::value(const Variable variable) {
+    return const_cast<std::optional<float>&>(
+            static_cast<const WeatherData&>(*this).value(variable));
+}
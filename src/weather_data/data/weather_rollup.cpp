@@ -0,0 +1,100 @@
+/**
+ * @file weather_rollup.cpp
+ * @date 10/16/2026
+ *
+ * @brief WeatherRollup class definition
+ */
+
+#include "data/weather_rollup.h"
+
+#include "date/date.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace {
+    /** @brief Get the calendar date of a timestamp */
+    date::year_month_day civilDate(const WeatherData::data_time time) {
+        return date::year_month_day{date::floor<date::days>(
+                date::sys_seconds{std::chrono::seconds{time}})};
+    }
+
+    /** @brief Get the timestamp of the first day of a month */
+    WeatherData::data_time monthStart(const int year, const int month) {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                date::sys_days{date::year{year}/month/1}.time_since_epoch()).count();
+    }
+}
+
+WeatherRollup::WeatherRollup(const std::vector<WeatherData>& data) {
+    for (const auto& weatherData : data) {
+        add(weatherData);
+    }
+}
+
+void WeatherRollup::add(const WeatherData& data) {
+    const auto ymd = civilDate(data.time.value());
+    auto& yearNode = mYears[static_cast<int>(ymd.year())];
+    yearNode.year.add(data);
+    yearNode.months[static_cast<unsigned>(ymd.month()) - 1].add(data);
+}
+
+void WeatherRollup::rebuildMonth(const WeatherData::data_time time,
+        const std::vector<WeatherData>& sorted_data) {
+    const auto ymd = civilDate(time);
+    const auto year = static_cast<int>(ymd.year());
+    const auto month = static_cast<int>(static_cast<unsigned>(ymd.month()));
+
+    const auto begin = monthStart(year, month);
+    const auto end = (month == 12) ? monthStart(year + 1, 1) : monthStart(year, month + 1);
+    const auto beginIt = std::lower_bound(sorted_data.cbegin(), sorted_data.cend(), begin,
+            [](const WeatherData& data, const WeatherData::data_time time) {
+                return data.time.value() < time;
+            });
+
+    auto& yearNode = mYears[year];
+    auto& monthSummary = yearNode.months[month - 1];
+    monthSummary = WeatherSummary();
+    for (auto it = beginIt; it != sorted_data.cend() && it->time.value() < end; ++it) {
+        monthSummary.add(*it);
+    }
+
+    yearNode.year = WeatherSummary();
+    for (const auto& summary : yearNode.months) {
+        yearNode.year.merge(summary);
+    }
+}
+
+std::vector<WeatherRollup::Row> WeatherRollup::table(const Period period) const {
+    std::vector<Row> rows;
+    // seasons are keyed by (year, season), since December belongs to the following year
+    std::map<std::pair<int, int>, WeatherSummary> seasons;
+    for (const auto& [year, yearNode] : mYears) {
+        if (period == Period::Year) {
+            if (yearNode.year.count > 0) {
+                rows.push_back({year, 0, yearNode.year});
+            }
+            continue;
+        }
+
+        for (int month = 1; month <= 12; ++month) {
+            const auto& summary = yearNode.months[month - 1];
+            if (summary.count == 0) {
+                continue;
+            }
+
+            if (period == Period::Month) {
+                rows.push_back({year, month, summary});
+            } else {
+                const auto seasonYear = (month == 12) ? year + 1 : year;
+                seasons[{seasonYear, (month % 12) / 3}].merge(summary);
+            }
+        }
+    }
+
+    for (const auto& [key, summary] : seasons) {
+        rows.push_back({key.first, key.second, summary});
+    }
+
+    return rows;
+}
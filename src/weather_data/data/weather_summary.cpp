@@ -0,0 +1,64 @@
+/**
+ * @file weather_summary.cpp
+ * @date 10/16/2026
+ *
+ * @brief VariableSummary and WeatherSummary struct definitions
+ */
+
+#include "data/weather_summary.h"
+
+#include <algorithm>
+#include <cmath>
+
+void VariableSummary::add(const float value) {
+    if (count == 0) {
+        min = value;
+        max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    ++count;
+    sum += value;
+}
+
+void VariableSummary::merge(const VariableSummary& other) {
+    if (other.count == 0) {
+        return;
+    }
+
+    if (count == 0) {
+        min = other.min;
+        max = other.max;
+    } else {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+    count += other.count;
+    sum += other.sum;
+}
+
+double VariableSummary::mean() const {
+    return count > 0 ? sum / count : std::nan("");
+}
+
+void WeatherSummary::add(const WeatherData& data) {
+    ++count;
+    for (std::size_t v = 0; v < WeatherData::VariableCount; ++v) {
+        const auto& value = data.value(static_cast<WeatherData::Variable>(v));
+        if (value.has_value()) {
+            variables[v].add(value.value());
+        }
+    }
+}
+
+void WeatherSummary::merge(const WeatherSummary& other) {
+    count += other.count;
+    for (std::size_t v = 0; v < WeatherData::VariableCount; ++v) {
+        variables[v].merge(other.variables[v]);
+    }
+}
+
+const VariableSummary& WeatherSummary::variable(const WeatherData::Variable variable) const {
+    return variables[static_cast<std::size_t>(variable)];
+}
@@ -0,0 +1,65 @@
+/**
+ * @file input_paths.cpp
+ * @date 10/17/2026
+ *
+ * @brief inputpaths namespace definition
+ */
+
+#include "input_paths.h"
+
+#include <glob.h>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+namespace inputpaths {
+
+    bool isGlobPattern(const std::string& path) {
+        return path.find_first_of("*?[") != std::string::npos;
+    }
+
+    std::vector<std::string> expandInputPaths(const std::vector<std::string>& paths) {
+        std::vector<std::string> filenames;
+        for (const auto& path : paths) {
+            std::error_code error;
+            if (std::filesystem::is_directory(path, error)) {
+                std::vector<std::string> directoryFiles;
+                for (std::filesystem::directory_iterator it(path, error), end; !error && it != end;
+                        it.increment(error)) {
+                    std::error_code entryError;
+                    if (it->is_regular_file(entryError) && it->path().extension() == ".json") {
+                        directoryFiles.push_back(it->path().string());
+                    }
+                }
+
+                if (error) {
+                    throw InputPathError("Unable to read the directory " + path + ": " + error.message());
+                } else if (directoryFiles.empty()) {
+                    throw InputPathError("The directory " + path + " does not contain any .json files");
+                }
+
+                // directory iteration order is unspecified, sort so precedence is well-defined
+                std::sort(directoryFiles.begin(), directoryFiles.end());
+                filenames.insert(filenames.end(), directoryFiles.begin(), directoryFiles.end());
+            } else if (isGlobPattern(path) && !std::filesystem::exists(path, error)) {
+                glob_t globResult;
+                // glob sorts the matching paths by default
+                const auto status = glob(path.c_str(), 0, nullptr, &globResult);
+                if (status == 0) {
+                    filenames.insert(filenames.end(),
+                            globResult.gl_pathv, globResult.gl_pathv + globResult.gl_pathc);
+                }
+                globfree(&globResult);
+
+                if (status != 0) {
+                    throw InputPathError("No files match the pattern " + path);
+                }
+            } else {
+                filenames.push_back(path);
+            }
+        }
+
+        return filenames;
+    }
+
+} // inputpaths
@@ -0,0 +1,138 @@
+/**
+ * @file json_object_scanner.cpp
+ * @date 10/16/2026
+ *
+ * @brief jsonparse::JsonObjectScanner class definition
+ */
+
+#include "json_object_scanner.h"
+#include "json_parse.h"
+
+#include <cctype>
+
+namespace jsonparse {
+
+    namespace {
+        /** @brief Size of the chunks the stream is read in */
+        constexpr std::size_t ChunkSize = 1 << 16;
+    }
+
+    JsonObjectScanner::JsonObjectScanner(std::istream& input) :
+        mInput(input),
+        mBuffer(ChunkSize) {}
+
+    bool JsonObjectScanner::nextChar(char& c) {
+        if (mBufferPos == mBufferSize) {
+            mInput.read(mBuffer.data(), mBuffer.size());
+            mBufferSize = static_cast<std::size_t>(mInput.gcount());
+            mBufferPos = 0;
+            if (mBufferSize == 0) {
+                return false;
+            }
+        }
+
+        c = mBuffer[mBufferPos++];
+        ++mStreamPos;
+        return true;
+    }
+
+    bool JsonObjectScanner::next(std::string& object_text, std::uint64_t& offset) {
+        if (mFinished) {
+            return false;
+        }
+
+        // find the start of the next object
+        char c;
+        while (true) {
+            if (!nextChar(c)) {
+                if (mStarted && mRootIsArray) {
+                    throw IncorrectJson("JSON array is not terminated");
+                }
+                mFinished = true;
+                return false;
+            }
+
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                continue;
+            } else if (c == '{') {
+                if (!mStarted) {
+                    mStarted = true; // root is a single object
+                    mFinished = true;
+                }
+                break;
+            } else if (!mStarted && c == '[') {
+                mStarted = true;
+                mRootIsArray = true;
+            } else if (mRootIsArray && c == ',') {
+                continue;
+            } else if (mRootIsArray && c == ']') {
+                mFinished = true;
+                return false;
+            } else {
+                throw IncorrectJson("JSON does not contain an array of objects");
+            }
+        }
+
+        // find the matching end of the object
+        offset = mStreamPos - 1;
+        object_text.assign(1, c);
+        int depth = 1;
+        bool inString = false;
+        bool escaped = false;
+        while (depth > 0) {
+            if (!nextChar(c)) {
+                throw IncorrectJson("JSON object is not terminated");
+            }
+            object_text.push_back(c);
+
+            if (inString) {
+                if (escaped) {
+                    escaped = false;
+                } else if (c == '\\') {
+                    escaped = true;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<std::int64_t> JsonObjectScanner::findDate(const std::string& object_text) {
+        const std::string dateKey = "\"" + DATE_KEY + "\"";
+        auto pos = object_text.find(dateKey);
+        while (pos != std::string::npos) {
+            auto valuePos = pos + dateKey.size();
+            while (valuePos < object_text.size()
+                    && std::isspace(static_cast<unsigned char>(object_text[valuePos]))) {
+                ++valuePos;
+            }
+
+            // a key is followed by ':', otherwise "date" was a value
+            if (valuePos < object_text.size() && object_text[valuePos] == ':') {
+                const auto stringStart = object_text.find_first_not_of(" \t\r\n", valuePos + 1);
+                // the date must be a string
+                if (stringStart == std::string::npos || object_text[stringStart] != '"') {
+                    return std::nullopt;
+                }
+                const auto stringEnd = object_text.find('"', stringStart + 1);
+                if (stringEnd == std::string::npos) {
+                    return std::nullopt;
+                }
+                return dateToUnix(object_text.substr(stringStart + 1, stringEnd - stringStart - 1));
+            }
+
+            pos = object_text.find(dateKey, pos + dateKey.size());
+        }
+
+        return std::nullopt;
+    }
+
+} // jsonparse
@@ -10,14 +10,47 @@
 #include <jsoncpp/json/reader.h>
 #include <jsoncpp/json/writer.h>
 #include "date/date.h"
+#include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
 #include <regex>
 #include <memory>
 #include <chrono>
+#include <fstream>
+#include <iterator>
 #include <sstream>
 
 namespace jsonparse {
 
+    std::optional<WeatherData::Variable> keyToVariable(const std::string& key) {
+        if (key == TMAX_KEY) {
+            return WeatherData::Variable::MaxTemp;
+        } else if (key == TMIN_KEY) {
+            return WeatherData::Variable::MinTemp;
+        } else if (key == TMEAN_KEY) {
+            return WeatherData::Variable::MeanTemp;
+        } else if (key == PPT_KEY) {
+            return WeatherData::Variable::GasPpt;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    const std::string& variableToKey(const WeatherData::Variable variable) {
+        switch (variable) {
+            case WeatherData::Variable::MaxTemp:
+                return TMAX_KEY;
+            case WeatherData::Variable::MinTemp:
+                return TMIN_KEY;
+            case WeatherData::Variable::MeanTemp:
+                return TMEAN_KEY;
+            case WeatherData::Variable::GasPpt:
+            default:
+                return PPT_KEY;
+        }
+    }
+
     Json::Value jsonFromString(const std::string& json_string) {
         const Json::CharReaderBuilder builder;
         const auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
@@ -39,6 +72,192 @@ namespace jsonparse {
         return Json::writeString(wbuilder, schema);
     }
 
+    std::string jsonCompact(const Json::Value& schema) {
+        Json::StreamWriterBuilder wbuilder;
+        wbuilder["precision"] = 6; // same precision as jsonPretty
+        wbuilder["indentation"] = "";
+        return Json::writeString(wbuilder, schema);
+    }
+
+    std::size_t formatNumber(const double value, char* buffer) {
+        if (!std::isfinite(value)) { // not weather data, leave it to jsoncpp
+            const auto text = jsonPretty(Json::Value(value));
+            const auto size = std::min(text.size(), NumberBufferSize);
+            std::copy_n(text.data(), size, buffer);
+            return size;
+        }
+
+        // to_chars with a precision is specified to match printf("%.6g"), which jsoncpp uses
+        const auto result = std::to_chars(
+                buffer, buffer + NumberBufferSize - 2, value, std::chars_format::general, 6);
+        auto end = result.ptr;
+
+        // jsoncpp marks whole numbers as doubles
+        if (std::find_if(buffer, end, [](const char c) { return c == '.' || c == 'e'; }) == end) {
+            *end++ = '.';
+            *end++ = '0';
+        }
+        return static_cast<std::size_t>(end - buffer);
+    }
+
+    namespace {
+
+        // variables in the order jsoncpp writes their keys (sorted)
+        constexpr WeatherData::Variable KeyOrder[] = {
+            WeatherData::Variable::GasPpt, WeatherData::Variable::MaxTemp,
+            WeatherData::Variable::MeanTemp, WeatherData::Variable::MinTemp};
+
+        void writeDateString(std::ostream& out, const WeatherData::data_time time, char* buffer) {
+            if (formatDate(time, buffer)) {
+                out << '"';
+                out.write(buffer, DateLength);
+                out << '"';
+            } else {
+                out << '"' << unixToDate(time) << '"';
+            }
+        }
+
+        void writeNumberOrNull(std::ostream& out, const float value, char* buffer) {
+            if (std::isnan(value)) {
+                out << "null";
+            } else {
+                out.write(buffer, static_cast<std::streamsize>(formatNumber(value, buffer)));
+            }
+        }
+
+    }
+
+    JsonArrayWriter::JsonArrayWriter(std::ostream& out, const bool compact) :
+        mOut(out), mCompact(compact) {}
+
+    void JsonArrayWriter::write(const Json::Value& element) {
+        if (mCompact) {
+            mOut << (mEmpty ? "[" : ",") << jsonCompact(element);
+            mEmpty = false;
+            return;
+        }
+
+        mOut << (mEmpty ? "[\n\t" : ",\n\t");
+        mEmpty = false;
+
+        // indent each line of the element by one level
+        const auto elementString = jsonPretty(element);
+        std::size_t lineStart = 0;
+        for (auto lineEnd = elementString.find('\n'); lineEnd != std::string::npos;
+                lineEnd = elementString.find('\n', lineStart)) {
+            mOut.write(elementString.data() + lineStart, lineEnd - lineStart + 1);
+            mOut << '\t';
+            lineStart = lineEnd + 1;
+        }
+        mOut.write(elementString.data() + lineStart, elementString.size() - lineStart);
+    }
+
+    void JsonArrayWriter::write(const WeatherData& data) {
+        if (mCompact) {
+            mOut << (mEmpty ? "[" : ",");
+        } else {
+            mOut << (mEmpty ? "[\n\t" : ",\n\t");
+        }
+        mEmpty = false;
+
+        // keys in the order jsoncpp writes them (sorted), each line indented by two levels
+        const char* const keyStart = mCompact ? "\"" : "\n\t\t\"";
+        const char* const keyEnd = mCompact ? "\":" : "\" : ";
+        char buffer[NumberBufferSize];
+        bool firstKey = true;
+        const auto writeKey = [&](const std::string& key) {
+            mOut << (firstKey ? "{" : ",") << keyStart << key << keyEnd;
+            firstKey = false;
+        };
+
+        if (data.time.has_value()) {
+            writeKey(DATE_KEY);
+            writeDateString(mOut, data.time.value(), buffer);
+        }
+        for (const auto variable : KeyOrder) {
+            const auto& value = data.value(variable);
+            if (value.has_value()) {
+                writeKey(variableToKey(variable));
+                writeNumberOrNull(mOut, value.value(), buffer);
+            }
+        }
+
+        if (firstKey) {
+            mOut << "{}";
+        } else {
+            mOut << (mCompact ? "}" : "\n\t}");
+        }
+    }
+
+    void JsonArrayWriter::close() {
+        if (mEmpty) {
+            mOut << "[]";
+        } else {
+            mOut << (mCompact ? "]" : "\n]");
+        }
+    }
+
+    void writeColumns(
+            std::ostream& out,
+            const WeatherColumns& columns,
+            const std::size_t first,
+            const std::size_t last) {
+        char buffer[NumberBufferSize];
+
+        const auto& times = columns.times();
+        out << "{\"" << DATE_KEY << "\":[";
+        for (auto i = first; i < last; i++) {
+            if (i != first) {
+                out << ',';
+            }
+            writeDateString(out, times[i], buffer);
+        }
+
+        for (const auto variable : KeyOrder) {
+            const auto& values = columns.values(variable);
+            out << "],\"" << variableToKey(variable) << "\":[";
+            for (auto i = first; i < last; i++) {
+                if (i != first) {
+                    out << ',';
+                }
+                writeNumberOrNull(out, values[i], buffer);
+            }
+        }
+        out << "]}";
+    }
+
+    void writeColumns(std::ostream& out, const std::vector<WeatherData>& data) {
+        char buffer[NumberBufferSize];
+
+        out << "{\"" << DATE_KEY << "\":[";
+        for (std::size_t i = 0; i < data.size(); i++) {
+            if (i != 0) {
+                out << ',';
+            }
+            if (data[i].time.has_value()) {
+                writeDateString(out, data[i].time.value(), buffer);
+            } else {
+                out << "null";
+            }
+        }
+
+        for (const auto variable : KeyOrder) {
+            out << "],\"" << variableToKey(variable) << "\":[";
+            for (std::size_t i = 0; i < data.size(); i++) {
+                if (i != 0) {
+                    out << ',';
+                }
+                const auto& value = data[i].value(variable);
+                if (value.has_value()) {
+                    writeNumberOrNull(out, value.value(), buffer);
+                } else {
+                    out << "null";
+                }
+            }
+        }
+        out << "]}";
+    }
+
     std::optional<std::chrono::seconds::rep> dateToUnix(const std::string& date_string) {
         // check that string contains a yyyy-mm-dd and capture year, month, day using regex
         std::smatch searchResult;
@@ -55,7 +274,43 @@ namespace jsonparse {
         }
     }
 
+    bool formatDate(const std::chrono::seconds::rep unix_time_sec, char* buffer) {
+        constexpr std::int64_t EraDays = 146097; // days in 400 years
+
+        // floor to days, then shift the epoch to 0000-03-01 so leap days end the year
+        const auto days = static_cast<std::int64_t>(WeatherData::dayNumber(unix_time_sec)) + 719468;
+        const auto era = (days >= 0 ? days : days - (EraDays - 1)) / EraDays;
+        const auto dayOfEra = days - era * EraDays;
+        const auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const auto shiftedMonth = (5 * dayOfYear + 2) / 153;
+        const auto day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+        const auto month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+        const auto year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+        if (year < 0 || year > 9999) {
+            return false;
+        }
+
+        buffer[0] = static_cast<char>('0' + year / 1000);
+        buffer[1] = static_cast<char>('0' + year / 100 % 10);
+        buffer[2] = static_cast<char>('0' + year / 10 % 10);
+        buffer[3] = static_cast<char>('0' + year % 10);
+        buffer[4] = '-';
+        buffer[5] = static_cast<char>('0' + month / 10);
+        buffer[6] = static_cast<char>('0' + month % 10);
+        buffer[7] = '-';
+        buffer[8] = static_cast<char>('0' + day / 10);
+        buffer[9] = static_cast<char>('0' + day % 10);
+        return true;
+    }
+
     std::string unixToDate(const std::chrono::seconds::rep& unix_time_sec) {
+        char buffer[DateLength];
+        if (formatDate(unix_time_sec, buffer)) {
+            return std::string(buffer, DateLength);
+        }
+
+        // years that are not 4 digits are formatted by the date library
         const auto dayObj = date::year_month_day{date::floor<date::days>(date::sys_seconds{
                 std::chrono::seconds(unix_time_sec)})};
 
@@ -94,10 +349,38 @@ namespace jsonparse {
         return data;
     }
 
+    std::vector<WeatherData> parseWeatherFile(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file) {
+            throw IncorrectJson("Unable to open file " + filename);
+        }
+
+        const auto schema = jsonFromString(
+                {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+
+        std::vector<WeatherData> fileData;
+        if (schema.isArray()) {
+            fileData.reserve(schema.size());
+            for (const auto& weatherSchema : schema) {
+                fileData.push_back(parseWeather(weatherSchema));
+            }
+        } else if (schema.isObject()) {
+            // file only contains a single weather data schema
+            fileData.push_back(parseWeather(schema));
+        }
+
+        return fileData;
+    }
+
     Json::Value createWeatherJson(const WeatherData& weather_data) {
-        Json::Value root;
+        Json::Value root(Json::objectValue); // {} rather than null without any data
         if (weather_data.time.has_value()) {
-            root[DATE_KEY] = unixToDate(weather_data.time.value());
+            char date[DateLength];
+            if (formatDate(weather_data.time.value(), date)) {
+                root[DATE_KEY] = Json::Value(date, date + DateLength);
+            } else {
+                root[DATE_KEY] = unixToDate(weather_data.time.value());
+            }
         }
 
         if (weather_data.maxTemp.has_value()) {
@@ -118,5 +401,33 @@ namespace jsonparse {
 
         return root;
     }
+
+    Json::Value createVariableSummaryJson(const VariableSummary& summary) {
+        Json::Value root;
+        root[COUNT_KEY] = static_cast<Json::UInt64>(summary.count);
+        if (summary.count > 0) {
+            root[MEAN_KEY] = summary.mean();
+            root[MIN_KEY] = summary.min;
+            root[MAX_KEY] = summary.max;
+        }
+
+        return root;
+    }
+
+    Json::Value createSummaryJson(const WeatherSummary& summary) {
+        Json::Value root;
+        root[COUNT_KEY] = static_cast<Json::UInt64>(summary.count);
+        for (std::size_t v = 0; v < WeatherData::VariableCount; ++v) {
+            const auto& variableSummary = summary.variables[v];
+            if (variableSummary.count == 0) {
+                continue;
+            }
+
+            root[variableToKey(static_cast<WeatherData::Variable>(v))] =
+                createVariableSummaryJson(variableSummary);
+        }
+
+        return root;
+    }
 } // jsonparse
 
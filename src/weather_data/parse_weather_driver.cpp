@@ -6,28 +6,65 @@
  */
 
 #include "parse_weather_driver.h"
+#include "arrow_stream_writer.h"
+#include "input_paths.h"
 #include "json_parse.h"
+#include "thread_pool.h"
+#include "weather_file_index.h"
+#include "weather_stream_reader.h"
 
 #include "jsoncpp/json/value.h"
 #include "date/date.h"
 #include <algorithm>
+#include <deque>
 #include <regex>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <map>
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include <numeric>
 #include <random>
+#include <sstream>
 #include <chrono>
 
+namespace {
+    /** @brief Write the YYYY-MM-DD date of a Unix time to a stream, without allocating */
+    std::ostream& writeDate(std::ostream& out, const WeatherData::data_time time) {
+        char date[jsonparse::DateLength];
+        if (jsonparse::formatDate(time, date)) {
+            return out.write(date, jsonparse::DateLength);
+        }
+        return out << jsonparse::unixToDate(time);
+    }
+
+}
+
 void ParseWeatherDriver::setOptions(CLI::App& app) {
-    // json input file is required. Use CLI to check that the file exists
+    // json input file is required. Use CLI to check that the files exist,
+    // glob patterns are checked when they are expanded
     mpFileOption = app.add_option(
             "-f, --file",
-            mInputFilename,
-            "Absolute path to json weather data file.\n"
-            "Ex: parseweather -f /home/path/to/file.json")
+            mInputFilenames,
+            "Absolute path to json weather data file. Multiple files, directories "
+            "(all .json files within), and quoted glob patterns are accepted.\n"
+            "Files are parsed in parallel. If multiple files contain data for the same "
+            "date, the data from the file listed last is used.\n"
+            "Ex: parseweather -f /home/path/to/file.json\n"
+            "Ex: parseweather -f /home/path/to/1990.json /home/path/to/1991.json\n"
+            "Ex: parseweather -f /home/path/to/dir \"/home/path/to/19*.json\"")
         ->required()
-        ->check(CLI::ExistingFile);
+        ->check([](const std::string& str) {
+                if (inputpaths::isGlobPattern(str) || std::filesystem::exists(str)) {
+                    return std::string();
+                } else {
+                    throw CLI::ValidationError(
+                            "FileOptionError",
+                            "File does not exist: " + str);
+                }
+            });
                 
     // date option
     mpDateOption = app.add_option(
@@ -95,12 +132,316 @@ void ParseWeatherDriver::setOptions(CLI::App& app) {
         ->excludes(mpDateOption) // excludes so that only one option is accepted at a time
         ->excludes(mpRangeOption)
         ->excludes(mpMeanOption);
+
+    mpSeedOption = app.add_option(
+            "--seed",
+            mSeed,
+            "Seed of the random draws of the --sample-history option. The same seed always "
+            "returns the same data, for any number of threads.\n"
+            "If not passed, a random seed is used.\nEx: --seed 42")
+        ->needs(mpSampleHistoryOption);
+
+    mpEnsembleOption = app.add_option(
+            "--ensemble",
+            mEnsembleSize,
+            "Return N independent samples of the --sample-history option, as newline delimited "
+            "JSON: one line per sample, with the \"member\" number (0 to N-1) and the sampled "
+            "\"data\" array. Member 0 is the same as the --sample-history option with the same "
+            "--seed.\nSamples are generated in parallel (see --threads) and written as they are "
+            "finished.\nEx: --ensemble 1000")
+        ->needs(mpSampleHistoryOption)
+        ->check([](const std::string& str) {
+            if (std::regex_match(str, std::regex("[1-9]\\d{0,8}"))) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("EnsembleOptionError", "Incorrect input for --ensemble option");
+            }
+        });
+
+    mpBlockLengthOption = app.add_option(
+            "--block-length",
+            mBlockLength,
+            "Used with --sample-history. Sample blocks of this many consecutive days from the "
+            "same year (a block bootstrap), instead of sampling every day from its own year, "
+            "which keeps the day to day persistence of the weather (ex. heat waves).\n"
+            "Blocks begin at the first date of the range. If the data following the first day "
+            "of a block is missing, that date is sampled on its own. Defaults to 1."
+            "\nEx: --block-length 10")
+        ->needs(mpSampleHistoryOption)
+        ->check([](const std::string& str) {
+            if (std::regex_match(str, std::regex("[1-9]\\d{0,4}"))) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("BlockLengthOptionError", "Incorrect input for --block-length option");
+            }
+        });
+
+    mpYearWeightsOption = app.add_option(
+            "--year-weights",
+            mYearWeights,
+            "Used with --sample-history. Draw some years more often than others, instead of "
+            "every year equally often. Possible options are:\n"
+            "linear: the first year of the year range has weight 1, the next 2, and so on.\n"
+            "exp:H: the weight halves every H years before the last year of the year range.\n"
+            "A file path: each line of the file is a year and its weight, separated by whitespace. "
+            "Years that are not listed are never drawn."
+            "\nEx: --year-weights exp:10  or --year-weights /home/path/to/weights.txt")
+        ->needs(mpSampleHistoryOption)
+        ->check([](const std::string& str) {
+            if (str == "linear" || std::regex_match(str, std::regex("exp:\\d{1,4}(\\.\\d+)?"))
+                    || std::filesystem::is_regular_file(str)) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("YearWeightsOptionError", "Incorrect input for --year-weights option");
+            }
+        });
+
+    // bands option, validity is easier checked with the parsed contents
+    mpBandsOption = app.add_option(
+            "--bands",
+            mBandsStrings,
+            "Used with --ensemble. Instead of the samples, return a JSON Array with percentiles "
+            "of the variable provided over all samples, for every date of the date range. The "
+            "samples are not kept, so memory use does not depend on the number of samples.\n"
+            "Percentiles (0 to 100) are separated by commas. Ensembles larger than 200 samples are "
+            "estimated, within 1% of the rank."
+            "\nPossible variable options are: tmax, tmin, tmean, and ppt."
+            "\nEx: --bands tmax 10,50,90")
+        ->expected(2)
+        ->needs(mpEnsembleOption);
+
+    mQueryOptions = {mpDateOption, mpRangeOption, mpMeanOption, mpSampleHistoryOption};
+
+    mpThreadsOption = app.add_option(
+            "--threads",
+            mThreadCount,
+            "Number of threads used to parse input files and to calculate aggregates over long "
+            "ranges (ex. the --mean option). Results do not depend on the number of threads.\n"
+            "Defaults to the number of hardware threads.\nEx: --threads 4")
+        ->check([](const std::string& str) {
+            if (std::regex_match(str, std::regex("[1-9]\\d{0,3}"))) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("ThreadsOptionError", "Incorrect input for --threads option");
+            }
+        });
+
+    mpOutputOption = app.add_option(
+            "--output",
+            mOutputString,
+            "Format of the weather data returned by the --range, --where, --top, and "
+            "--sample-history options. Possible options are:\n"
+            "pretty: an indented JSON Array (the default).\n"
+            "compact: the same JSON Array on a single line, without whitespace.\n"
+            "columnar: a single JSON Object with an array for each key (\"date\", \"ppt\", "
+            "\"tmax\", \"tmean\", and \"tmin\"), with null where data is missing. With --stream, "
+            "the data of the range is held in memory until it is written.\n"
+            "arrow: binary Apache Arrow IPC stream with a date32 \"date\" column and a float32 "
+            "column for each variable, with null where data is missing.\n"
+            "Cannot be used with --ensemble or --bands, which have their own formats."
+            "\nEx: --output compact  or --output arrow > range.arrows")
+        ->excludes(mpEnsembleOption)
+        ->excludes(mpBandsOption)
+        ->check([this](const std::string& str) {
+            if (OutputFormats.count(str) != 0) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("OutputOptionError", "Incorrect input for --output option");
+            }
+        });
+
+    // max and min options, validity is easier checked with the parsed contents
+    mpMaxOption = addQueryOption(app.add_option(
+            "--max",
+            mOptionMultiString,
+            "Return the date and value of the largest measurement of the variable provided "
+            "within the specific time range.\n"
+            "If data within the range is missing, only present data is searched. "
+            "If the largest value occurs more than once, the earliest date is returned.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nPossible variable options are: tmax, tmin, tmean, and ppt."
+            "\nEx: --max 2022-01-01|2022-12-31 tmax  or --max tmax 2022-01-01|2022-12-31")
+        ->expected(2));
+
+    mpMinOption = addQueryOption(app.add_option(
+            "--min",
+            mOptionMultiString,
+            "Return the date and value of the smallest measurement of the variable provided "
+            "within the specific time range. Inputs are the same as the --max option."
+            "\nEx: --min 2022-01-01|2022-12-31 tmin")
+        ->expected(2));
+
+    mpRollupOption = addQueryOption(app.add_option(
+            "--rollup",
+            mOptionSingleString,
+            "Return a JSON Array with the count, mean, minimum and maximum of each variable for "
+            "every month, season, or year of the data.\n"
+            "Seasons are meteorological: DJF, MAM, JJA, and SON. A DJF season belongs to the year "
+            "of its January.\n"
+            "Possible options are: month, season, and year.\nEx: --rollup month")
+        ->check([this](const std::string& str) {
+            if (RollupPeriods.count(str) != 0) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("RollupOptionError", "Incorrect input for --rollup option");
+            }
+        }));
+
+    mpNormalsOption = addQueryOption(app.add_option(
+            "--normals",
+            mOptionSingleString,
+            "Return a JSON Array with the count, mean, minimum and maximum of each variable for "
+            "every calendar day (MM-DD), over every year of the year range.\n"
+            "February 29th only includes leap years.\n"
+            "The year range must be formatted as YYYY|YYYY\nEx: --normals 1991|2020")
+        ->check([this](const std::string& str) {
+            if (checkYearRange(str)) {
+                return std::string();
+            } else {
+                throw CLI::ValidationError("NormalsOptionError", "Incorrect input for --normals option");
+            }
+        }));
+
+    // rolling option, validity is easier checked with the parsed contents
+    mpRollingOption = addQueryOption(app.add_option(
+            "--rolling",
+            mOptionMultiString,
+            "Return a JSON Array with the moving count, mean, minimum and maximum of the variable "
+            "provided for every date within the specific time range. The window of a date covers "
+            "the window length in days, ending at that date.\n"
+            "If data within a window is missing, only present data is used.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nPossible variable options are: tmax, tmin, tmean, and ppt."
+            "\nEx: --rolling tmax 30 2022-01-01|2022-12-31")
+        ->expected(3));
+
+    // percentile option, validity is easier checked with the parsed contents
+    mpPercentileOption = addQueryOption(app.add_option(
+            "--percentile",
+            mOptionMultiString,
+            "Return the percentile (0 to 100) of the variable provided within the specific "
+            "time range. Ex: 50 is the median.\n"
+            "If data within the range is missing, only present data is used. Ranges longer than "
+            "4096 days are estimated from monthly sketches, within 1% of the rank.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nPossible variable options are: tmax, tmin, tmean, and ppt."
+            "\nEx: --percentile 95 tmax 2022-01-01|2022-12-31")
+        ->expected(3));
+
+    // condition options, validity is easier checked with the parsed contents
+    mpCountWhereOption = addQueryOption(app.add_option(
+            "--count-where",
+            mOptionMultiString,
+            "Return the number of dates within the specific time range whose data meets a "
+            "condition. Dates missing the variable of the condition never meet it.\n"
+            "The condition is a variable (tmax, tmin, tmean, or ppt), a comparison (<, <=, =, >=, "
+            "or >), and a number, and should be quoted.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nEx: --count-where \"tmax>35\" 1990-01-01|2020-12-31")
+        ->expected(2));
+
+    mpWhereOption = addQueryOption(app.add_option(
+            "--where",
+            mOptionMultiString,
+            "Return the weather data of the dates within the specific time range whose data meets "
+            "a condition, as a JSON Array. Inputs are the same as the --count-where option."
+            "\nEx: --where \"ppt=0\" 2022-01-01|2022-12-31")
+        ->expected(2));
+
+    // top option, validity is easier checked with the parsed contents
+    mpTopOption = addQueryOption(app.add_option(
+            "--top",
+            mOptionMultiString,
+            "Return the weather data of the K dates with the largest measurements of the variable "
+            "provided within the specific time range, as a JSON Array, largest first.\n"
+            "If data within the range is missing, only present data is searched. "
+            "If values are tied, the earliest date is returned first.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nPossible variable options are: tmax, tmin, tmean, and ppt."
+            "\nEx: --top 10 tmax 2022-01-01|2022-12-31")
+        ->expected(3));
+
+    // runs option, validity is easier checked with the parsed contents
+    mpRunsOption = addQueryOption(app.add_option(
+            "--runs",
+            mOptionMultiString,
+            "Return a JSON Array of the runs of at least N consecutive days within the specific time "
+            "range whose data meets a condition (ex. heat waves or dry spells), with the start and "
+            "end date, number of days, and peak of each run.\n"
+            "A missing date, or a date missing the variable of the condition, ends a run.\n"
+            "The condition is the same as the --count-where option, and should be quoted.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nEx: --runs \"tmax>35\" 3 1990-01-01|2020-12-31")
+        ->expected(3));
+
+    // degree days option, validity is easier checked with the parsed contents
+    mpDegreeDaysOption = addQueryOption(app.add_option(
+            "--degree-days",
+            mOptionMultiString,
+            "Return the heating degree days (sum of max(0, base - temperature)) and cooling degree "
+            "days (sum of max(0, temperature - base)) within the specific time range, for a base "
+            "temperature in Celcius.\n"
+            "The temperature of a date is tmean, or the average of tmax and tmin if tmean is missing. "
+            "Dates without either are ignored.\n"
+            "The date range must be formatted as YYYY-MM-DD|YYYY-MM-DD."
+            "\nEx: --degree-days 18 2022-01-01|2022-12-31")
+        ->expected(2));
+
+    // lazy mode, only parse the data needed by the --date or --range option
+    mpLazyOption = app.add_flag(
+            "--lazy",
+            "Only parse the data needed to answer the --date or --range option, "
+            "instead of loading the whole file.\n"
+            "The file is scanned once to find the date and location of each data point, "
+            "then only the requested data is parsed. Requires a single input file.\n"
+            "Ex: --lazy -d 2022-01-01")
+        ->excludes(mpMeanOption)
+        ->excludes(mpSampleHistoryOption);
+
+    mpIndexFileOption = app.add_flag(
+            "--index-file",
+            "Used with --lazy. Save the scanned locations of the data as an index file next "
+            "to the input file (<file>.idx), and reuse it while the input file is unchanged.\n"
+            "Ex: --lazy --index-file -d 2022-01-01")
+        ->needs(mpLazyOption);
+
+    // streaming mode, answer queries without loading the whole file
+    mpStreamOption = app.add_flag(
+            "--stream",
+            "Answer the --date, --range, or --mean option while scanning the input files once, "
+            "without loading them into memory. Use this for files larger than the available memory.\n"
+            "Range data is output in the order it appears in the files, once per occurrence of a "
+            "date. The --date and --mean options use the last occurrence of a date, like without "
+            "--stream. The --mean option keeps one value per date of the range, unless the input is "
+            "a single file that is sorted (see --sorted), which is scanned in constant memory.\n"
+            "Ex: --stream -r 2022-01-01|2022-12-31")
+        ->excludes(mpLazyOption)
+        ->excludes(mpSampleHistoryOption);
+
+    mpSortedOption = app.add_flag(
+            "--sorted",
+            "Used with --stream. The input files are in increasing date order, so a scan can stop "
+            "once it passes the requested dates. Files with an --index-file sidecar that records "
+            "they are sorted are detected automatically.\n"
+            "Ex: --stream --sorted -m tmax 2022-01-01|2022-12-31")
+        ->needs(mpStreamOption);
 }
 
 void ParseWeatherDriver::run(CLI::App& app) {
+    mOutputFormat = OutputFormats.at(mOutputString); // validated by the --output option
+
     // This should always be true since this is required, but be safe and check
     if (mpFileOption && mpFileOption->count()) { 
-        if (!readInputFile()) { // error messages are output within this function
+        // lazy and streaming modes answer the query straight from the files
+        if (mpLazyOption && mpLazyOption->count()) {
+            runLazyOption(); // can throw CLI::ValidationError
+            return;
+        } else if (mpStreamOption && mpStreamOption->count()) {
+            runStreamOption(); // can throw CLI::ValidationError
+            return;
+        }
+
+        if (!readInputFiles()) { // error messages are output within this function
             return;
         }
     } else {
@@ -118,9 +459,39 @@ void ParseWeatherDriver::run(CLI::App& app) {
         runMeanOption(); // can throw CLI::ValidationError
     } else if (mpSampleHistoryOption && mpSampleHistoryOption->count()) {
         runSampleHistoryOption();
+    } else if (mpMaxOption && mpMaxOption->count()) {
+        runExtremumOption(true); // can throw CLI::ValidationError
+    } else if (mpMinOption && mpMinOption->count()) {
+        runExtremumOption(false); // can throw CLI::ValidationError
+    } else if (mpRollupOption && mpRollupOption->count()) {
+        runRollupOption();
+    } else if (mpNormalsOption && mpNormalsOption->count()) {
+        runNormalsOption();
+    } else if (mpRollingOption && mpRollingOption->count()) {
+        runRollingOption(); // can throw CLI::ValidationError
+    } else if (mpPercentileOption && mpPercentileOption->count()) {
+        runPercentileOption(); // can throw CLI::ValidationError
+    } else if (mpCountWhereOption && mpCountWhereOption->count()) {
+        runWhereOption(true); // can throw CLI::ValidationError
+    } else if (mpWhereOption && mpWhereOption->count()) {
+        runWhereOption(false); // can throw CLI::ValidationError
+    } else if (mpTopOption && mpTopOption->count()) {
+        runTopOption(); // can throw CLI::ValidationError
+    } else if (mpRunsOption && mpRunsOption->count()) {
+        runRunsOption(); // can throw CLI::ValidationError
+    } else if (mpDegreeDaysOption && mpDegreeDaysOption->count()) {
+        runDegreeDaysOption(); // can throw CLI::ValidationError
     }
 }
 
+CLI::Option* ParseWeatherDriver::addQueryOption(CLI::Option* option) {
+    for (auto* queryOption : mQueryOptions) {
+        option->excludes(queryOption);
+    }
+    mQueryOptions.push_back(option);
+    return option;
+}
+
 bool ParseWeatherDriver::checkDateRange(const std::string& range_string) const {
 
     if (range_string.size() != DateRangeLength) {
@@ -135,56 +506,237 @@ bool ParseWeatherDriver::checkDateRange(const std::string& range_string) const {
         && startUnix <= finishUnix;
 }
 
-bool ParseWeatherDriver::readInputFile() {
-    // Read the json file into a Json::Value object
-    Json::Value schema;
+bool ParseWeatherDriver::expandInputPaths(std::vector<std::string>& filenames) const {
     try {
-        std::ifstream file(mInputFilename);
-        schema = jsonparse::jsonFromString(
-                {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+        filenames = inputpaths::expandInputPaths(mInputFilenames);
+    } catch (const inputpaths::InputPathError& error) {
+        std::cerr << error.what() << "\n";
+        return false;
+    }
+    return true;
+}
 
-    } catch (const jsonparse::IncorrectJson& error) {
-        std::cerr << "An error occured parsing the json file: " << error.what() << "\n";
+bool ParseWeatherDriver::readInputFiles() {
+    std::vector<std::string> filenames;
+    if (!expandInputPaths(filenames)) { // error messages are output within this function
         return false;
     }
 
-    if (schema.isArray()) {
-        // Check this is an array of weather data schema's
-        for (auto i = 0; i < schema.size(); ++i) {
-            const Json::Value weatherSchema = schema[i];
-            try {
-                mArchive.addData(jsonparse::parseWeather(weatherSchema));
-            } catch (const jsonparse::IncorrectJson& error) {
-                std::cerr << "An error occurred parsing the json file: "
-                    << error.what() << "\n";
-                return false;
-            }
+    // parse each file on its own thread, the largest file bounds the total time
+    std::vector<std::future<std::vector<WeatherData>>> fileData;
+    fileData.reserve(filenames.size());
+    {
+        ThreadPool pool(std::min<std::size_t>(filenames.size(), mThreadCount));
+        for (const auto& filename : filenames) {
+            fileData.push_back(pool.submit([&filename]() {
+                        return jsonparse::parseWeatherFile(filename);
+                    }));
         }
-    } else if (schema.isObject()) {
-        // Check if file only contains a single weather data schema 
+    } // pool waits for all files to finish parsing
+
+    // collect all results before modifying mArchive, so it is untouched on error
+    std::vector<std::vector<WeatherData>> parsedFiles;
+    parsedFiles.reserve(fileData.size());
+    for (std::size_t i = 0; i < fileData.size(); ++i) {
         try {
-            mArchive.addData(jsonparse::parseWeather(schema));
+            parsedFiles.push_back(fileData[i].get());
         } catch (const jsonparse::IncorrectJson& error) {
-            std::cerr << "An error occurred parsing the json file: "
-                << error.what() << "\n";
+            std::cerr << "An error occurred parsing the json file " << filenames[i]
+                << ": " << error.what() << "\n";
             return false;
         }
     }
 
+    // merge in the order the files were passed, so later files take precedence
+    for (auto& data : parsedFiles) {
+        mArchive.addBatch(std::move(data));
+    }
+
     return true;
 }
 
+void ParseWeatherDriver::runLazyOption() const {
+    std::vector<std::string> filenames;
+    if (!expandInputPaths(filenames)) { // error messages are output within this function
+        return;
+    }
+
+    if (filenames.size() != 1) {
+        throw CLI::ValidationError(
+                "LazyOptionError",
+                "The --lazy option requires a single input file\n");
+    }
+
+    const bool isDateQuery = mpDateOption && mpDateOption->count();
+    const bool isRangeQuery = mpRangeOption && mpRangeOption->count();
+    if (!isDateQuery && !isRangeQuery) {
+        throw CLI::ValidationError(
+                "LazyOptionError",
+                "The --lazy option can only be used with the -d, --date or -r, --range option\n");
+    }
+
+    try {
+        const auto index = (mpIndexFileOption && mpIndexFileOption->count()) ?
+            WeatherFileIndex::loadOrBuild(filenames.front()) :
+            WeatherFileIndex::build(filenames.front());
+
+        if (isDateQuery) {
+            const auto unixTime = jsonparse::dateToUnix(mOptionSingleString);
+            if (unixTime.has_value()) {
+                printDateResult(index.retrieve(unixTime.value()));
+            } else {
+                std::cerr << "An error occurred parsing the input date: "
+                    << mOptionSingleString << "\n";
+            }
+        } else {
+            const auto startUnix = jsonparse::dateToUnix(mOptionSingleString.substr(0, 10));
+            const auto finishUnix = jsonparse::dateToUnix(mOptionSingleString.substr(11, 10));
+            printWeatherData(index.retrieveRange(startUnix.value(), finishUnix.value()));
+        }
+    } catch (const jsonparse::IncorrectJson& error) {
+        std::cerr << "An error occurred parsing the json file " << filenames.front()
+            << ": " << error.what() << "\n";
+    }
+}
+
+void ParseWeatherDriver::runStreamOption() const {
+    const bool isDateQuery = mpDateOption && mpDateOption->count();
+    const bool isRangeQuery = mpRangeOption && mpRangeOption->count();
+    const bool isMeanQuery = mpMeanOption && mpMeanOption->count();
+    if (!isDateQuery && !isRangeQuery && !isMeanQuery) {
+        throw CLI::ValidationError(
+                "StreamOptionError",
+                "The --stream option can only be used with the -d, --date, -r, --range, "
+                "or -m, --mean option\n");
+    }
+
+    std::string rangeString;
+    std::string variableName;
+    if (isMeanQuery) {
+        checkRangeVariableInputs("-m, --mean", "MeanOptionError", rangeString, variableName);
+    } else if (isRangeQuery) {
+        rangeString = mOptionSingleString;
+    } else {
+        rangeString = mOptionSingleString + "|" + mOptionSingleString;
+    }
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+    if (!startUnix.has_value() || !finishUnix.has_value()) {
+        std::cerr << "An error occurred parsing the input date: "
+            << (isDateQuery ? mOptionSingleString : rangeString) << "\n";
+        return;
+    }
+
+    std::vector<std::string> filenames;
+    if (!expandInputPaths(filenames)) { // error messages are output within this function
+        return;
+    }
+
+    // columns are written one after another, so the range is collected first
+    const bool isColumnar = mOutputFormat == OutputFormat::Columnar;
+    std::vector<WeatherData> rangeData;
+    std::optional<ArrowStreamWriter> arrowWriter;
+    if (isRangeQuery && mOutputFormat == OutputFormat::Arrow) {
+        arrowWriter.emplace(std::cout);
+    }
+
+    std::optional<WeatherData> dateData;
+    jsonparse::JsonArrayWriter rangeWriter(std::cout, mOutputFormat == OutputFormat::Compact);
+
+    // the range output is closed on errors too, so the data written so far stays valid
+    const auto closeRangeOutput = [&]() {
+        if (arrowWriter.has_value()) {
+            arrowWriter->close();
+        } else if (isRangeQuery && !isColumnar) {
+            rangeWriter.close();
+            std::cout << "\n";
+        }
+    };
+
+    // a single sorted file has no repeated dates, so the mean is summed as the file is
+    // scanned. Otherwise later data of a date takes precedence like mArchive, so the mean
+    // keeps one value per date of the range (memory depends on the length of the range)
+    std::size_t meanCount = 0;
+    double meanSum = 0;
+    const auto addMeanValue = [&](const WeatherData::data_time time, const std::optional<float>& value) {
+        if (value.has_value()) {
+            meanCount++;
+            meanSum += value.value();
+        } else {
+            writeDate(std::cerr << "Data for date: ", time)
+                << " is missing \"" << variableName << "\" and will be ignored for "
+                "calcuating the mean\n";
+        }
+    };
+    std::map<WeatherData::data_time, std::optional<float>> meanValues;
+    for (const auto& filename : filenames) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            std::cerr << "Unable to open file " << filename << "\n";
+            closeRangeOutput();
+            return;
+        }
+        const bool sorted = (mpSortedOption && mpSortedOption->count())
+            || WeatherFileIndex::sidecarFileSorted(filename).value_or(false);
+        WeatherStreamReader reader(file, sorted);
+
+        try {
+            reader.readRange(startUnix.value(), finishUnix.value(), [&](const WeatherData& data) {
+                if (isDateQuery) {
+                    dateData = data; // later data takes precedence, like mArchive
+                } else if (isRangeQuery && isColumnar) {
+                    rangeData.push_back(data);
+                } else if (isRangeQuery && arrowWriter.has_value()) {
+                    arrowWriter->write(data);
+                } else if (isRangeQuery) {
+                    rangeWriter.write(data);
+                } else if (sorted && filenames.size() == 1) {
+                    addMeanValue(data.time.value(),
+                            data.value(jsonparse::keyToVariable(variableName).value()));
+                } else {
+                    meanValues[data.time.value()] =
+                        data.value(jsonparse::keyToVariable(variableName).value());
+                }
+            });
+        } catch (const jsonparse::IncorrectJson& error) {
+            std::cerr << "An error occurred parsing the json file " << filename
+                << ": " << error.what() << "\n";
+            if (isRangeQuery && !isColumnar) {
+                std::cerr << "The output only contains the data before the error\n";
+            }
+            closeRangeOutput();
+            return;
+        }
+    }
+
+    if (isDateQuery) {
+        printDateResult(dateData);
+    } else if (isRangeQuery && isColumnar) {
+        printWeatherData(rangeData);
+    } else if (isRangeQuery) {
+        closeRangeOutput();
+    } else {
+        for (const auto& [time, value] : meanValues) {
+            addMeanValue(time, value);
+        }
+        printMean(meanCount > 0 ? meanSum / meanCount : std::nan(""), rangeString, variableName);
+    }
+}
+
+void ParseWeatherDriver::printDateResult(const std::optional<WeatherData>& data) const {
+    if (data.has_value()) {
+        std::cout << 
+            jsonparse::jsonPretty(jsonparse::createWeatherJson(data.value())) << "\n";
+    } else {
+        std::cerr << "Data for date: " << mOptionSingleString << " is not available\n";
+    }
+}
+
 void ParseWeatherDriver::runDateOption() const {
     // mOptionSingleString will contain the YYYY-MM-DD string to look up in mArchive
     const auto unixTime = jsonparse::dateToUnix(mOptionSingleString);
     if (unixTime.has_value()) {
-        const auto dataOptional = mArchive.retrieve(unixTime.value());
-        if (dataOptional.has_value()) {
-            std::cout << 
-                jsonparse::jsonPretty(jsonparse::createWeatherJson(dataOptional.value())) << "\n";
-        } else {
-            std::cerr << "Data for date: " << mOptionSingleString << " is not available\n";
-        }
+        printDateResult(mArchive.retrieve(unixTime.value()));
     } else {
         std::cerr << "An error occurred parsing the input date: " << mOptionSingleString << "\n";
     }
@@ -194,79 +746,478 @@ void ParseWeatherDriver::runRangeOption() const {
     const auto startUnix = jsonparse::dateToUnix(mOptionSingleString.substr(0, 10));
     const auto finishUnix = jsonparse::dateToUnix(mOptionSingleString.substr(11, 10));
 
-    printWeatherData(mArchive.retrieveRange(startUnix.value(), finishUnix.value())); 
+    // columnar and arrow output is written straight from the column storage, without
+    // copying the range
+    switch (mOutputFormat) {
+    case OutputFormat::Columnar: {
+        const auto columns = mArchive.columns();
+        const auto range = columns->range(startUnix.value(), finishUnix.value());
+        jsonparse::writeColumns(std::cout, *columns, range.first, range.second);
+        std::cout << "\n";
+        break;
+    }
+    case OutputFormat::Arrow: {
+        const auto columns = mArchive.columns();
+        const auto range = columns->range(startUnix.value(), finishUnix.value());
+        ArrowStreamWriter writer(std::cout);
+        writer.write(*columns, range.first, range.second);
+        writer.close();
+        break;
+    }
+    case OutputFormat::Pretty:
+    case OutputFormat::Compact:
+        printWeatherData(mArchive.retrieveRange(startUnix.value(), finishUnix.value()));
+        break;
+    }
 }
 
 void ParseWeatherDriver::printWeatherData(const std::vector<WeatherData>& data) const {
-    // create a json array for printing
-    Json::Value outputArray = Json::arrayValue;
-    for (const auto& data : data) {
-        outputArray.append(jsonparse::createWeatherJson(data));
+    switch (mOutputFormat) {
+    case OutputFormat::Columnar:
+        jsonparse::writeColumns(std::cout, data);
+        std::cout << "\n";
+        break;
+    case OutputFormat::Arrow: {
+        ArrowStreamWriter writer(std::cout);
+        for (const auto& data : data) {
+            writer.write(data);
+        }
+        writer.close();
+        break;
+    }
+    case OutputFormat::Pretty:
+    case OutputFormat::Compact: {
+        // the writer formats the data directly, the output is the same as jsonPretty (or
+        // jsonCompact) of the array
+        jsonparse::JsonArrayWriter writer(std::cout, mOutputFormat == OutputFormat::Compact);
+        for (const auto& data : data) {
+            writer.write(data);
+        }
+        writer.close();
+        std::cout << "\n";
+        break;
+    }
     }
-
-    std::cout << jsonparse::jsonPretty(outputArray) << "\n";
 }
 
-// expecting there to be two inputs for this option!
-void ParseWeatherDriver::runMeanOption() const {
+void ParseWeatherDriver::checkRangeAndArgument(
+        const std::string& option_name,
+        const std::string& error_name,
+        std::string& range_string,
+        std::string& argument) const {
 
     if (mOptionMultiString.size() != 2) { // cli11 should guarentee this
         throw CLI::ValidationError(
-                "MeanOptionError",
-                "Incorrect input for -m, --mean option. This option expects "
+                error_name,
+                "Incorrect input for " + option_name + " option. This option expects "
                 "two inputs\n");
     }
 
-    // one of the inputs should be a date range string, the other should be a
-    // variable name
+    // one of the inputs should be a date range string, the other is the argument
+    std::size_t argumentIndex;
     if (checkDateRange(mOptionMultiString[0])) {
-        const auto it = std::find(
-                VariableStrings.cbegin(),
-                VariableStrings.cend(),
-                mOptionMultiString[1]);
-
-        if (it != VariableStrings.end()) {
-            const auto mean = calcVariableMean(mOptionMultiString[0], *it);
-            if (std::isnan(mean)) {
-                std::cerr << "Could not calculate a mean; data for variable \""
-                    << *it << "\" is not present within the time range " 
-                    << mOptionMultiString[0] << "\n";
-            } else {
-                std::cout << std::fixed << std::setprecision(3) << mean << "\n";
-            }
+        argumentIndex = 1;
+    } else if (checkDateRange(mOptionMultiString[1])) {
+        argumentIndex = 0;
+    } else {
+        throw CLI::ValidationError(
+                error_name,
+                "Incorrect input for " + option_name + " option. This option expects one "
+                "input to be a date range\n");
+    }
+
+    range_string = mOptionMultiString[1 - argumentIndex];
+    argument = mOptionMultiString[argumentIndex];
+}
+
+void ParseWeatherDriver::checkRangeVariableInputs(
+        const std::string& option_name,
+        const std::string& error_name,
+        std::string& range_string,
+        std::string& variable_name) const {
+
+    std::string argument;
+    checkRangeAndArgument(option_name, error_name, range_string, argument);
+
+    const auto it = std::find(VariableStrings.cbegin(), VariableStrings.cend(), argument);
+    if (it == VariableStrings.end()) {
+        throw CLI::ValidationError(
+                error_name,
+                "Incorrect input for " + option_name + " option. The variable \""
+                + argument + "\" is not recognized\n");
+    }
+
+    variable_name = *it;
+}
+
+// expecting there to be two inputs for this option!
+void ParseWeatherDriver::runMeanOption() const {
+    std::string rangeString;
+    std::string variableName;
+    checkRangeVariableInputs("-m, --mean", "MeanOptionError", rangeString, variableName);
+
+    printMean(calcVariableMean(rangeString, variableName), rangeString, variableName);
+}
+
+void ParseWeatherDriver::checkRangeVariableNumberInputs(
+        const std::string& option_name,
+        const std::string& error_name,
+        const std::regex& number_regex,
+        std::string& range_string,
+        std::string& variable_name,
+        std::string& number_string) const {
+
+    if (mOptionMultiString.size() != 3) { // cli11 should guarentee this
+        throw CLI::ValidationError(
+                error_name,
+                "Incorrect input for " + option_name + " option. This option expects "
+                "three inputs\n");
+    }
+
+    range_string.clear();
+    variable_name.clear();
+    number_string.clear();
+    for (const auto& input : mOptionMultiString) {
+        if (checkDateRange(input)) {
+            range_string = input;
+        } else if (std::regex_match(input, number_regex)) {
+            number_string = input;
+        } else if (std::find(VariableStrings.cbegin(), VariableStrings.cend(), input)
+                != VariableStrings.cend()) {
+            variable_name = input;
         } else {
             throw CLI::ValidationError(
-                    "MeanOptionError",
-                    "Incorrect input for -m, --mean option. The variable \""
-                    + mOptionMultiString[1] + "\" is not recognized\n");
+                    error_name,
+                    "Incorrect input for " + option_name + " option. The input \""
+                    + input + "\" is not recognized\n");
         }
-    } else if (checkDateRange(mOptionMultiString[1])) {
-        const auto it = std::find(
-                VariableStrings.cbegin(),
-                VariableStrings.cend(),
-                mOptionMultiString[0]);
-
-        if (it != VariableStrings.end()) {
-            const auto mean = calcVariableMean(mOptionMultiString[1], *it);
-            if (std::isnan(mean)) {
-                std::cerr << "Could not calculate a mean; data for variable \""
-                    << *it << "\" is not present within the time range " 
-                    << mOptionMultiString[1] << "\n";
-            } else {
-                std::cout << std::fixed << std::setprecision(3) << mean << "\n";
+    }
+
+    if (range_string.empty() || variable_name.empty() || number_string.empty()) {
+        throw CLI::ValidationError(
+                error_name,
+                "Incorrect input for " + option_name + " option. This option expects a "
+                "date range, a variable, and a number\n");
+    }
+}
+
+void ParseWeatherDriver::printMean(
+        const double mean,
+        const std::string& range_string,
+        const std::string& variable_name) const {
+    if (std::isnan(mean)) {
+        std::cerr << "Could not calculate a mean; data for variable \""
+            << variable_name << "\" is not present within the time range " 
+            << range_string << "\n";
+    } else {
+        std::cout << std::fixed << std::setprecision(3) << mean << "\n";
+    }
+}
+
+void ParseWeatherDriver::runExtremumOption(const bool find_max) const {
+    std::string rangeString;
+    std::string variableName;
+    if (find_max) {
+        checkRangeVariableInputs("--max", "MaxOptionError", rangeString, variableName);
+    } else {
+        checkRangeVariableInputs("--min", "MinOptionError", rangeString, variableName);
+    }
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+    const auto variable = jsonparse::keyToVariable(variableName).value();
+
+    const auto dataOpt = find_max ?
+        mArchive.retrieveMax(variable, startUnix.value(), finishUnix.value()) :
+        mArchive.retrieveMin(variable, startUnix.value(), finishUnix.value());
+
+    if (dataOpt.has_value()) {
+        // only output the date and the variable that was searched
+        WeatherData extremum;
+        extremum.time = dataOpt.value().time;
+        extremum.value(variable) = dataOpt.value().value(variable);
+        std::cout << jsonparse::jsonPretty(jsonparse::createWeatherJson(extremum)) << "\n";
+    } else {
+        std::cerr << "Could not find a " << (find_max ? "maximum" : "minimum")
+            << "; data for variable \"" << variableName
+            << "\" is not present within the time range " << rangeString << "\n";
+    }
+}
+
+void ParseWeatherDriver::runRollupOption() const {
+    static const std::string SeasonNames[] = {"DJF", "MAM", "JJA", "SON"};
+
+    const auto period = RollupPeriods.at(mOptionSingleString); // validated by the --rollup option
+
+    jsonparse::JsonArrayWriter writer(std::cout);
+    for (const auto& row : mArchive.rollup().table(period)) {
+        std::ostringstream label;
+        label << std::setfill('0') << std::setw(4) << row.year;
+        if (period == WeatherRollup::Period::Month) {
+            label << '-' << std::setw(2) << row.index;
+        } else if (period == WeatherRollup::Period::Season) {
+            label << '-' << SeasonNames[row.index];
+        }
+
+        auto rowJson = jsonparse::createSummaryJson(row.summary);
+        rowJson[jsonparse::PERIOD_KEY] = label.str();
+        writer.write(rowJson);
+    }
+    writer.close();
+    std::cout << "\n";
+}
+
+void ParseWeatherDriver::runNormalsOption() const {
+    // since the parser validates the year range, stoi will not throw
+    const auto normals = mArchive.normals(
+            std::stoi(mOptionSingleString.substr(0, 4)),
+            std::stoi(mOptionSingleString.substr(5)));
+
+    jsonparse::JsonArrayWriter writer(std::cout);
+    for (unsigned month = 1; month <= 12; ++month) {
+        for (unsigned day = 1;
+                ClimatologyNormals::dayIndex(month, day) != ClimatologyNormals::DayCount; ++day) {
+            const auto& summary = normals->day(month, day);
+            if (summary.count == 0) {
+                continue;
             }
+
+            std::ostringstream label;
+            label << std::setfill('0') << std::setw(2) << month << '-' << std::setw(2) << day;
+
+            auto dayJson = jsonparse::createSummaryJson(summary);
+            dayJson[jsonparse::DAY_KEY] = label.str();
+            writer.write(dayJson);
+        }
+    }
+    writer.close();
+    std::cout << "\n";
+}
+
+void ParseWeatherDriver::runRollingOption() const {
+    static const std::regex windowRegex("[1-9]\\d{0,4}");
+
+    std::string rangeString;
+    std::string variableName;
+    std::string windowString;
+    checkRangeVariableNumberInputs("--rolling", "RollingOptionError", windowRegex,
+            rangeString, variableName, windowString);
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+
+    jsonparse::JsonArrayWriter writer(std::cout);
+    mArchive.retrieveRolling(
+            jsonparse::keyToVariable(variableName).value(),
+            std::stoi(windowString) * WeatherData::DaySeconds, // regex validates the window, stoi will not throw
+            startUnix.value(),
+            finishUnix.value(),
+            [&writer](const WeatherData::data_time time, const VariableSummary& summary) {
+                auto stepJson = jsonparse::createVariableSummaryJson(summary);
+                stepJson[jsonparse::DATE_KEY] = jsonparse::unixToDate(time);
+                writer.write(stepJson);
+            });
+    writer.close();
+    std::cout << "\n";
+}
+
+void ParseWeatherDriver::runPercentileOption() const {
+    static const std::regex percentileRegex("100|\\d{1,2}(\\.\\d+)?");
+
+    std::string rangeString;
+    std::string variableName;
+    std::string percentileString;
+    checkRangeVariableNumberInputs("--percentile", "PercentileOptionError", percentileRegex,
+            rangeString, variableName, percentileString);
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+
+    // regex validates the percentile, stod will not throw
+    const auto percentile = mArchive.retrievePercentile(
+            jsonparse::keyToVariable(variableName).value(),
+            std::stod(percentileString),
+            startUnix.value(),
+            finishUnix.value());
+
+    if (percentile.has_value()) {
+        std::cout << std::fixed << std::setprecision(3) << percentile.value() << "\n";
+    } else {
+        std::cerr << "Could not find a percentile; data for variable \"" << variableName
+            << "\" is not present within the time range " << rangeString << "\n";
+    }
+}
+
+bool ParseWeatherDriver::parseCondition(
+        const std::string& condition,
+        WeatherData::Variable& variable,
+        ValueBitmapIndex::Comparison& comparison,
+        float& threshold) const {
+    static const std::regex conditionRegex("(tmax|tmin|tmean|ppt)(<=|>=|<|>|=)(-?\\d+(\\.\\d+)?)");
+
+    std::smatch match;
+    if (!std::regex_match(condition, match, conditionRegex)) {
+        return false;
+    }
+
+    comparison = ValueBitmapIndex::Comparison::Equal;
+    if (match.str(2) == "<") {
+        comparison = ValueBitmapIndex::Comparison::Less;
+    } else if (match.str(2) == "<=") {
+        comparison = ValueBitmapIndex::Comparison::LessEqual;
+    } else if (match.str(2) == ">=") {
+        comparison = ValueBitmapIndex::Comparison::GreaterEqual;
+    } else if (match.str(2) == ">") {
+        comparison = ValueBitmapIndex::Comparison::Greater;
+    }
+
+    variable = jsonparse::keyToVariable(match.str(1)).value();
+    threshold = std::stof(match.str(3)); // regex validates the number, stof will not throw
+    return true;
+}
+
+void ParseWeatherDriver::runWhereOption(const bool count_only) const {
+    const std::string optionName = count_only ? "--count-where" : "--where";
+    const std::string errorName = count_only ? "CountWhereOptionError" : "WhereOptionError";
+
+    // one of the inputs should be a date range string, the other should be a condition
+    std::string rangeString;
+    std::string conditionString;
+    checkRangeAndArgument(optionName, errorName, rangeString, conditionString);
+
+    WeatherData::Variable variable;
+    ValueBitmapIndex::Comparison comparison;
+    float threshold;
+    if (!parseCondition(conditionString, variable, comparison, threshold)) {
+        throw CLI::ValidationError(
+                errorName,
+                "Incorrect input for " + optionName + " option. The condition \""
+                + conditionString + "\" is not recognized\n");
+    }
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+
+    if (count_only) {
+        std::cout << mArchive.countWhere(
+                variable, comparison, threshold, startUnix.value(), finishUnix.value()) << "\n";
+    } else {
+        printWeatherData(mArchive.retrieveWhere(
+                    variable, comparison, threshold, startUnix.value(), finishUnix.value()));
+    }
+}
+
+void ParseWeatherDriver::runRunsOption() const {
+    static const std::regex lengthRegex("[1-9]\\d{0,4}");
+
+    if (mOptionMultiString.size() != 3) { // cli11 should guarentee this
+        throw CLI::ValidationError(
+                "RunsOptionError",
+                "Incorrect input for --runs option. This option expects three inputs\n");
+    }
+
+    std::string rangeString;
+    std::string lengthString;
+    WeatherData::Variable variable;
+    ValueBitmapIndex::Comparison comparison;
+    float threshold;
+    bool hasCondition = false;
+    for (const auto& input : mOptionMultiString) {
+        if (checkDateRange(input)) {
+            rangeString = input;
+        } else if (std::regex_match(input, lengthRegex)) {
+            lengthString = input;
+        } else if (parseCondition(input, variable, comparison, threshold)) {
+            hasCondition = true;
         } else {
             throw CLI::ValidationError(
-                    "MeanOptionError",
-                    "Incorrect input for -m, --mean option. The variable \""
-                    + mOptionMultiString[0] + "\" is not recognized\n");
+                    "RunsOptionError",
+                    "Incorrect input for --runs option. The input \"" + input + "\" is not recognized\n");
         }
-    } else {
+    }
+
+    if (rangeString.empty() || lengthString.empty() || !hasCondition) {
         throw CLI::ValidationError(
-                "MeanOptionError",
-                "Incorrect input for -m, --mean option. This option expects one "
-                "input to be a date range\n");
+                "RunsOptionError",
+                "Incorrect input for --runs option. This option expects a condition, "
+                "a minimum number of days, and a date range\n");
     }
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+
+    jsonparse::JsonArrayWriter writer(std::cout);
+    mArchive.retrieveRuns(
+            variable,
+            comparison,
+            threshold,
+            std::stoul(lengthString), // regex validates the length, stoul will not throw
+            startUnix.value(),
+            finishUnix.value(),
+            [&](const WeatherData& first, const WeatherData& last,
+                const WeatherData& peak, const std::size_t length) {
+                // only output the date and the variable of the peak
+                WeatherData peakData;
+                peakData.time = peak.time;
+                peakData.value(variable) = peak.value(variable);
+
+                Json::Value runJson;
+                runJson[jsonparse::START_KEY] = jsonparse::unixToDate(first.time.value());
+                runJson[jsonparse::END_KEY] = jsonparse::unixToDate(last.time.value());
+                runJson[jsonparse::LENGTH_KEY] = static_cast<Json::UInt64>(length);
+                runJson[jsonparse::PEAK_KEY] = jsonparse::createWeatherJson(peakData);
+                writer.write(runJson);
+            });
+    writer.close();
+    std::cout << "\n";
+}
+
+void ParseWeatherDriver::runDegreeDaysOption() const {
+    static const std::regex baseRegex("-?\\d{1,3}(\\.\\d+)?");
+
+    // one of the inputs should be a date range string, the other should be the base
+    std::string rangeString;
+    std::string baseString;
+    checkRangeAndArgument("--degree-days", "DegreeDaysOptionError", rangeString, baseString);
+
+    if (!std::regex_match(baseString, baseRegex)) {
+        throw CLI::ValidationError(
+                "DegreeDaysOptionError",
+                "Incorrect input for --degree-days option. The base temperature \""
+                + baseString + "\" is not a number\n");
+    }
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+
+    // regex validates the base, stof will not throw
+    const auto degreeDays = mArchive.retrieveDegreeDays(
+            std::stof(baseString), startUnix.value(), finishUnix.value());
+
+    Json::Value degreeDaysJson;
+    degreeDaysJson[jsonparse::HEATING_KEY] = degreeDays.heating;
+    degreeDaysJson[jsonparse::COOLING_KEY] = degreeDays.cooling;
+    degreeDaysJson[jsonparse::COUNT_KEY] = static_cast<Json::UInt64>(degreeDays.count);
+    std::cout << jsonparse::jsonPretty(degreeDaysJson) << "\n";
+}
+
+void ParseWeatherDriver::runTopOption() const {
+    static const std::regex countRegex("[1-9]\\d{0,5}");
+
+    std::string rangeString;
+    std::string variableName;
+    std::string countString;
+    checkRangeVariableNumberInputs("--top", "TopOptionError", countRegex,
+            rangeString, variableName, countString);
+
+    const auto startUnix = jsonparse::dateToUnix(rangeString.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(rangeString.substr(11, 10));
+
+    printWeatherData(mArchive.retrieveTop(
+                jsonparse::keyToVariable(variableName).value(),
+                std::stoul(countString), // regex validates the count, stoul will not throw
+                startUnix.value(),
+                finishUnix.value()));
 }
 
 double ParseWeatherDriver::calcVariableMean(
@@ -275,63 +1226,29 @@ double ParseWeatherDriver::calcVariableMean(
     const auto startUnix = jsonparse::dateToUnix(range_string.substr(0, 10));
     const auto finishUnix = jsonparse::dateToUnix(range_string.substr(11, 10));
 
-    const auto rangeData = mArchive.retrieveRange(
-            startUnix.value(), finishUnix.value()); 
+    const auto variable = jsonparse::keyToVariable(variable_name);
+    if (!variable.has_value()) { // handling unrecognized variable name occurs within runMeanOption
+        return std::nan("");
+    }
 
-    std::size_t count = 0;
-    double sum = 0;
-    if (variable_name == jsonparse::TMAX_KEY) {
-        for (const auto& data : rangeData) {
-            if (data.maxTemp.has_value()) {
-                count++;
-                sum += data.maxTemp.value();;
-            } else {
-                std::cerr << "Data for date: " << jsonparse::unixToDate(data.time.value())
-                    << " is missing \"" << variable_name << "\" and will be ignored for "
-                    "calcuating the mean\n";
-            }
-        }
+    const auto summary = mArchive.summarizeRange(
+            variable.value(), startUnix.value(), finishUnix.value(), mThreadCount);
 
-    } else if (variable_name == jsonparse::TMIN_KEY) {
-        for (const auto& data : rangeData) {
-            if (data.minTemp.has_value()) {
-                count++;
-                sum += data.minTemp.value();;
-            } else {
-                std::cerr << "Data for date: " << jsonparse::unixToDate(data.time.value())
-                    << " is missing \"" << variable_name << "\" and will be ignored for "
-                    "calcuating the mean\n";
-            }
-        }
-    } else if (variable_name == jsonparse::TMEAN_KEY) {
-        for (const auto& data : rangeData) {
-            if (data.meanTemp.has_value()) {
-                count++;
-                sum += data.meanTemp.value();;
-            } else {
-                std::cerr << "Data for date: " << jsonparse::unixToDate(data.time.value())
-                    << " is missing \"" << variable_name << "\" and will be ignored for "
-                    "calcuating the mean\n";
-            }
-        }
-    } else if (variable_name == jsonparse::PPT_KEY) {
-        for (const auto& data : rangeData) {
-            if (data.gas_ppt.has_value()) {
-                count++;
-                sum += data.gas_ppt.value();;
-            } else {
-                std::cerr << "Data for date: " << jsonparse::unixToDate(data.time.value())
+    // only revisit the range to report missing data when some is missing
+    const auto columns = mArchive.columns();
+    const auto range = columns->range(startUnix.value(), finishUnix.value());
+    if (summary.count < range.second - range.first) {
+        const auto& values = columns->values(variable.value());
+        for (auto i = range.first; i < range.second; ++i) {
+            if (std::isnan(values[i])) {
+                writeDate(std::cerr << "Data for date: ", columns->times()[i])
                     << " is missing \"" << variable_name << "\" and will be ignored for "
                     "calcuating the mean\n";
             }
         }
-    }  // handling unrecognized variable name occurs within runMeanOption
-
-    if (count > 0) {
-        return sum / count;
-    } else {
-        return std::nan("");
     }
+
+    return summary.mean();
 }
 
 void ParseWeatherDriver::runSampleHistoryOption() const {
@@ -344,17 +1261,185 @@ void ParseWeatherDriver::runSampleHistoryOption() const {
 
     // one of the inputs should be a date range string, the other should be a
     // year range string
+    std::size_t dateRangeIndex;
     if (checkDateRange(mOptionMultiString[0]) 
             && checkYearRange(mOptionMultiString[1])) {
-        printWeatherData(sampleHistoricalData(mOptionMultiString[0], mOptionMultiString[1]));
+        dateRangeIndex = 0;
     } else if (checkDateRange(mOptionMultiString[1]) 
             && checkYearRange(mOptionMultiString[0])) {
-        printWeatherData(sampleHistoricalData(mOptionMultiString[1], mOptionMultiString[0]));
+        dateRangeIndex = 1;
     } else {
         throw CLI::ValidationError(
                 "SampleHistoryOptionError",
                 "Incorrect input for -s, --sample-history option.\n");
     }
+
+    auto seed = mSeed;
+    if (!mpSeedOption || !mpSeedOption->count()) {
+        std::random_device device;
+        seed = (static_cast<std::uint64_t>(device()) << 32) | device();
+    }
+
+    const auto& dateRange = mOptionMultiString[dateRangeIndex];
+    const auto& yearRange = mOptionMultiString[1 - dateRangeIndex];
+    const auto yearWeights = readYearWeights(yearRange); // can throw CLI::ValidationError
+    if (mpBandsOption && mpBandsOption->count()) {
+        printEnsembleBands(dateRange, yearRange, seed, yearWeights); // can throw CLI::ValidationError
+    } else if (mpEnsembleOption && mpEnsembleOption->count()) {
+        printEnsemble(dateRange, yearRange, seed, yearWeights);
+    } else {
+        printWeatherData(sampleHistoricalData(dateRange, yearRange, seed, yearWeights, 0, mThreadCount));
+    }
+}
+
+void ParseWeatherDriver::printEnsemble(
+        const std::string& date_range,
+        const std::string& year_range,
+        const std::uint64_t seed,
+        const std::vector<double>& year_weights) const {
+    // build the sampler of the year range once, before the members share it
+    mArchive.sampler(std::stoi(year_range.substr(0, 4)), std::stoi(year_range.substr(5)), year_weights);
+
+    // each member is sampled and formatted by one thread, lines are written in member order
+    // and at most two lines per thread are waiting to be written
+    ThreadPool pool(mThreadCount);
+    std::deque<std::future<std::string>> pending;
+    for (std::size_t member = 0; member < mEnsembleSize; ++member) {
+        pending.push_back(pool.submit([&, member]() {
+            // keys in the order jsoncpp writes them (sorted)
+            std::ostringstream line;
+            line << "{\"" << jsonparse::DATA_KEY << "\":";
+            jsonparse::JsonArrayWriter writer(line, true);
+            for (const auto& data : sampleHistoricalData(date_range, year_range, seed, year_weights, member)) {
+                writer.write(data);
+            }
+            writer.close();
+            line << ",\"" << jsonparse::MEMBER_KEY << "\":" << member << "}";
+            return line.str();
+        }));
+
+        if (pending.size() >= 2 * pool.size()) {
+            std::cout << pending.front().get() << "\n";
+            pending.pop_front();
+        }
+    }
+
+    for (auto& line : pending) {
+        std::cout << line.get() << "\n";
+    }
+}
+
+void ParseWeatherDriver::printEnsembleBands(
+        const std::string& date_range,
+        const std::string& year_range,
+        const std::uint64_t seed,
+        const std::vector<double>& year_weights) const {
+    static const std::regex percentilesRegex("\\d{1,3}(\\.\\d+)?(,\\d{1,3}(\\.\\d+)?)*");
+
+    // inputs are the variable and the percentiles, in any order
+    if (mBandsStrings.size() != 2) { // cli11 should guarentee this
+        throw CLI::ValidationError(
+                "BandsOptionError",
+                "Incorrect input for --bands option. This option expects two inputs\n");
+    }
+    const std::size_t variableIndex = jsonparse::keyToVariable(mBandsStrings[0]).has_value() ? 0 : 1;
+    const auto variable = jsonparse::keyToVariable(mBandsStrings[variableIndex]);
+    const auto& percentilesString = mBandsStrings[1 - variableIndex];
+    if (!variable.has_value() || !std::regex_match(percentilesString, percentilesRegex)) {
+        throw CLI::ValidationError(
+                "BandsOptionError",
+                "Incorrect input for --bands option. This option expects a variable and a comma "
+                "separated list of percentiles\n");
+    }
+
+    std::vector<std::pair<std::string, double>> percentiles;
+    std::istringstream percentileStream(percentilesString);
+    for (std::string percentile; std::getline(percentileStream, percentile, ','); ) {
+        // regex validates the percentile, stod will not throw
+        if (std::stod(percentile) > 100) {
+            throw CLI::ValidationError(
+                    "BandsOptionError",
+                    "Incorrect input for --bands option. The percentile " + percentile
+                    + " is not between 0 and 100\n");
+        }
+        percentiles.emplace_back("p" + percentile, std::stod(percentile) / 100);
+    }
+
+    const auto startUnix = jsonparse::dateToUnix(date_range.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(date_range.substr(11, 10));
+    const auto bands = mArchive.sampleBands(variable.value(), mEnsembleSize,
+            startUnix.value(), finishUnix.value(),
+            std::stoi(year_range.substr(0, 4)), std::stoi(year_range.substr(5)),
+            seed, mThreadCount, mBlockLength, year_weights);
+
+    jsonparse::JsonArrayWriter writer(std::cout);
+    for (std::size_t day = 0; day < bands.size(); ++day) {
+        if (bands[day].count() == 0) {
+            continue; // no year has data for the date
+        }
+
+        Json::Value dayJson;
+        dayJson[jsonparse::DATE_KEY] = jsonparse::unixToDate(
+                startUnix.value() + static_cast<WeatherData::data_time>(day) * WeatherData::DaySeconds);
+        dayJson[jsonparse::COUNT_KEY] = static_cast<Json::UInt64>(bands[day].count());
+        for (const auto& [key, fraction] : percentiles) {
+            dayJson[key] = bands[day].quantile(fraction).value();
+        }
+        writer.write(dayJson);
+    }
+    writer.close();
+    std::cout << "\n";
+}
+
+std::vector<double> ParseWeatherDriver::readYearWeights(const std::string& year_range) const {
+    if (!mpYearWeightsOption || !mpYearWeightsOption->count()) {
+        return {};
+    }
+
+    // since regex validates years, stoi will not throw
+    const auto firstYear = std::stoi(year_range.substr(0, 4));
+    const auto lastYear = std::stoi(year_range.substr(5));
+    std::vector<double> weights(static_cast<std::size_t>(lastYear - firstYear + 1));
+
+    if (mYearWeights == "linear") {
+        std::iota(weights.begin(), weights.end(), 1.0);
+    } else if (mYearWeights.rfind("exp:", 0) == 0) {
+        const auto halfLife = std::stod(mYearWeights.substr(4)); // validated by the option check
+        if (!(halfLife > 0)) {
+            throw CLI::ValidationError(
+                    "YearWeightsOptionError",
+                    "Incorrect input for --year-weights option. The half life must be positive\n");
+        }
+        for (std::size_t i = 0; i < weights.size(); ++i) {
+            weights[i] = std::exp2((static_cast<double>(i) - static_cast<double>(weights.size() - 1)) / halfLife);
+        }
+    } else {
+        std::ifstream file(mYearWeights);
+        std::string line;
+        for (auto lineNumber = 1; std::getline(file, line); ++lineNumber) {
+            std::istringstream lineStream(line);
+            int year;
+            double weight;
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue; // skip blank lines
+            } else if (!(lineStream >> year >> weight) || !(weight >= 0)) {
+                throw CLI::ValidationError(
+                        "YearWeightsOptionError",
+                        "Incorrect line " + std::to_string(lineNumber) + " of the --year-weights file "
+                        + mYearWeights + ". Each line must be a year and a non-negative weight\n");
+            } else if (year >= firstYear && year <= lastYear) {
+                weights[static_cast<std::size_t>(year - firstYear)] = weight;
+            }
+        }
+    }
+
+    if (std::none_of(weights.cbegin(), weights.cend(), [](const double weight) { return weight > 0; })) {
+        throw CLI::ValidationError(
+                "YearWeightsOptionError",
+                "Incorrect input for --year-weights option. No year of the year range has a "
+                "positive weight\n");
+    }
+    return weights;
 }
 
 bool ParseWeatherDriver::checkYearRange(const std::string& year_range) const {
@@ -376,79 +1461,22 @@ bool ParseWeatherDriver::checkYearRange(const std::string& year_range) const {
 
 std::vector<WeatherData> ParseWeatherDriver::sampleHistoricalData(
             const std::string& date_range,
-            const std::string& year_range) const {
-
-    date::sys_days startDays;
-    std::smatch searchResult;
-    if (std::regex_match(
-                date_range.cbegin(), date_range.cbegin() + 10,
-                searchResult, jsonparse::dateRegex)) {
-        // date library syntax is year/month/day
-        startDays = date::year{std::stoi(searchResult.str(1))} /
-            std::stoi(searchResult.str(2))/
-            std::stoi(searchResult.str(3));
-    } else { // should not occur since date_range has already been verified for correct format
+            const std::string& year_range,
+            const std::uint64_t seed,
+            const std::vector<double>& year_weights,
+            const std::uint64_t member,
+            const std::size_t thread_count) const {
+    const auto startUnix = jsonparse::dateToUnix(date_range.substr(0, 10));
+    const auto finishUnix = jsonparse::dateToUnix(date_range.substr(11, 10));
+    if (!startUnix.has_value() || !finishUnix.has_value()) {
+        // should not occur since date_range has already been verified for correct format
         return {};
     }
 
-    date::sys_days finishDays;
-    if (std::regex_match(
-                date_range.cbegin() + 11, date_range.cend(),
-                searchResult, jsonparse::dateRegex)) {
-        // date library syntax is year/month/day
-        finishDays = date::year{std::stoi(searchResult.str(1))} /
-            std::stoi(searchResult.str(2))/
-            std::stoi(searchResult.str(3));
-    } else {
-        return {};
-    }
-
-    std::vector<WeatherData> retData; // vector that is returned
-
+    // since regex validates years, stoi will not throw
     const auto startSampleYears = std::stoi(year_range.substr(0, 4));
     const auto finishSampleYears = std::stoi(year_range.substr(5));
 
-    // initialize a vector with the possible sample years
-    std::vector<int> sampleYears(finishSampleYears - startSampleYears + 1);
-    std::iota(sampleYears.begin(), sampleYears.end(), startSampleYears);
-
-    auto numGenerator = std::mt19937{std::random_device{}()};  // random_device for shuffle
-    for (auto i = startDays; i <= finishDays; ) {
-        const date::year_month_day ymd = i;
-
-        /* Randomly shuffle the vector containing the sample years.
-         * Starting with the year in the front of the vector, attempt to get the data point
-         * from that year. If there is no data point, try the next year.
-         * If there is not data point at all, then this is an error!
-        */
-        std::shuffle(sampleYears.begin(), sampleYears.end(), numGenerator);
-
-        auto dataOpt = [&]() -> std::optional<WeatherData> {
-            for (const auto& year : sampleYears) {
-                // create year_month_day object, then convert it UTM/GMT time,
-                // and finally query mArchive for the data
-                const auto sampleData = mArchive.retrieve(
-                        std::chrono::duration_cast<std::chrono::seconds>(
-                            date::sys_days{date::year{year}/ymd.month()/ymd.day()}.time_since_epoch()
-                        ).count());
-
-                if (sampleData.has_value()) {
-                    return sampleData;
-                }
-            }
-
-            return std::nullopt;
-        }();
-
-        if (dataOpt.has_value()) {
-            // assign the time for the expected output
-            dataOpt.value().time = std::chrono::duration_cast<std::chrono::seconds>(
-                    i.time_since_epoch()).count();
-            retData.push_back(dataOpt.value());
-        } 
-
-        i = i + date::days{1}; // move time by one day
-    }
-
-    return retData;
+    return mArchive.sampleHistory(startUnix.value(), finishUnix.value(),
+            startSampleYears, finishSampleYears, seed, thread_count, member, mBlockLength, year_weights);
 }
@@ -0,0 +1,50 @@
+/**
+ * @file thread_pool.cpp
+ * @date 10/16/2026
+ *
+ * @brief ThreadPool class definition
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(const std::size_t thread_count) {
+    const auto workerCount = std::max<std::size_t>(thread_count, 1);
+    mWorkers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        mWorkers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mTaskAvailable.notify_all();
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return mWorkers.size();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mTaskAvailable.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+            // finish any remaining tasks before stopping
+            if (mTasks.empty()) {
+                return;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop();
+        }
+        task();
+    }
+}
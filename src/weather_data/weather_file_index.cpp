@@ -0,0 +1,248 @@
+/**
+ * @file weather_file_index.cpp
+ * @date 10/16/2026
+ *
+ * @brief WeatherFileIndex class definition
+ */
+
+#include "weather_file_index.h"
+#include "json_object_scanner.h"
+#include "json_parse.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace {
+    /** @brief Identifies a sidecar index file */
+    constexpr char SidecarMagic[4] = {'W', 'D', 'I', 'X'};
+
+    /** @brief Version of the sidecar file format */
+    constexpr std::uint32_t SidecarVersion = 1;
+
+    /** @brief Extension appended to the JSON filename to form the sidecar filename */
+    const std::string SidecarExtension {".idx"};
+
+    // entries are written to the sidecar as raw bytes
+    static_assert(sizeof(WeatherFileIndex::Entry) == 24, "Entry must not contain padding");
+
+    template <typename T>
+    void writeValue(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+WeatherFileIndex WeatherFileIndex::build(const std::string& filename) {
+    WeatherFileIndex index;
+    index.mFilename = filename;
+    if (!fileStamp(filename, index.mFileSize, index.mFileTime)) {
+        throw jsonparse::IncorrectJson("Unable to open file " + filename);
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw jsonparse::IncorrectJson("Unable to open file " + filename);
+    }
+
+    jsonparse::JsonObjectScanner scanner(file);
+    std::string objectText;
+    std::uint64_t offset;
+    while (scanner.next(objectText, offset)) {
+        const auto time = jsonparse::JsonObjectScanner::findDate(objectText);
+        if (time.has_value()) {
+            if (!index.mEntries.empty() && index.mEntries.back().time >= time.value()) {
+                index.mFileSorted = false;
+            }
+            index.mEntries.push_back({time.value(), offset, objectText.size()});
+        }
+    }
+
+    if (!index.mFileSorted) {
+        // keep the last object of each duplicated date, like WeatherArchive::addBatch
+        auto& entries = index.mEntries;
+        std::stable_sort(entries.begin(), entries.end(),
+                [](const Entry& lhs, const Entry& rhs) { return lhs.time < rhs.time; });
+        const auto uniqueEnd = std::unique(entries.rbegin(), entries.rend(),
+                [](const Entry& lhs, const Entry& rhs) { return lhs.time == rhs.time; });
+        entries.erase(entries.begin(), uniqueEnd.base());
+    }
+
+    return index;
+}
+
+std::optional<WeatherFileIndex> WeatherFileIndex::loadSidecar(const std::string& filename) {
+    WeatherFileIndex index;
+    index.mFilename = filename;
+    std::ifstream sidecar;
+    std::uint64_t entryCount;
+    if (!openSidecar(filename, sidecar, index.mFileSorted, entryCount)) {
+        return std::nullopt;
+    }
+
+    index.mEntries.resize(entryCount);
+    if (!sidecar.read(reinterpret_cast<char*>(index.mEntries.data()),
+                entryCount * sizeof(Entry))) {
+        return std::nullopt;
+    }
+
+    // a valid sidecar was saved for the current file
+    fileStamp(filename, index.mFileSize, index.mFileTime);
+    return index;
+}
+
+std::optional<bool> WeatherFileIndex::sidecarFileSorted(const std::string& filename) {
+    std::ifstream sidecar;
+    bool fileSorted;
+    std::uint64_t entryCount;
+    if (openSidecar(filename, sidecar, fileSorted, entryCount)) {
+        return fileSorted;
+    } else {
+        return std::nullopt;
+    }
+}
+
+WeatherFileIndex WeatherFileIndex::loadOrBuild(const std::string& filename) {
+    auto index = loadSidecar(filename);
+    if (index.has_value()) {
+        return std::move(index.value());
+    }
+
+    auto builtIndex = build(filename);
+    builtIndex.saveSidecar(); // the index is still usable if saving fails
+    return builtIndex;
+}
+
+std::string WeatherFileIndex::sidecarFilename(const std::string& filename) {
+    return filename + SidecarExtension;
+}
+
+bool WeatherFileIndex::saveSidecar() const {
+    std::ofstream sidecar(sidecarFilename(mFilename), std::ios::binary | std::ios::trunc);
+    if (!sidecar) {
+        return false;
+    }
+
+    sidecar.write(SidecarMagic, sizeof(SidecarMagic));
+    writeValue(sidecar, SidecarVersion);
+    writeValue(sidecar, mFileSize);
+    writeValue(sidecar, mFileTime);
+    writeValue(sidecar, static_cast<std::uint8_t>(mFileSorted));
+    writeValue(sidecar, static_cast<std::uint64_t>(mEntries.size()));
+    sidecar.write(reinterpret_cast<const char*>(mEntries.data()),
+            mEntries.size() * sizeof(Entry));
+
+    return static_cast<bool>(sidecar);
+}
+
+std::optional<WeatherData> WeatherFileIndex::retrieve(const WeatherData::data_time time) const {
+    const auto it = std::lower_bound(mEntries.cbegin(), mEntries.cend(), time,
+            [](const Entry& entry, const WeatherData::data_time time) {
+                return entry.time < time;
+            });
+
+    if (it != mEntries.cend() && it->time == time) {
+        std::ifstream file(mFilename, std::ios::binary);
+        return parseEntry(file, *it);
+    } else {
+        return std::nullopt;
+    }
+}
+
+std::vector<WeatherData> WeatherFileIndex::retrieveRange(
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec) const {
+    std::vector<WeatherData> retData;
+    if (begin_sec > end_sec) {
+        return retData;
+    }
+
+    const auto beginIt = std::lower_bound(mEntries.cbegin(), mEntries.cend(), begin_sec,
+            [](const Entry& entry, const WeatherData::data_time time) {
+                return entry.time < time;
+            });
+    const auto endIt = std::upper_bound(beginIt, mEntries.cend(), end_sec,
+            [](const WeatherData::data_time time, const Entry& entry) {
+                return time < entry.time;
+            });
+
+    std::ifstream file(mFilename, std::ios::binary);
+    retData.reserve(std::distance(beginIt, endIt));
+    for (auto it = beginIt; it != endIt; ++it) {
+        retData.push_back(parseEntry(file, *it));
+    }
+
+    return retData;
+}
+
+const std::vector<WeatherFileIndex::Entry>& WeatherFileIndex::entries() const {
+    return mEntries;
+}
+
+bool WeatherFileIndex::fileSorted() const {
+    return mFileSorted;
+}
+
+WeatherData WeatherFileIndex::parseEntry(std::istream& file, const Entry& entry) {
+    std::string objectText(entry.length, '\0');
+    if (!file.seekg(entry.offset) || !file.read(objectText.data(), objectText.size())) {
+        throw jsonparse::IncorrectJson("Unable to read weather data from the file");
+    }
+
+    return jsonparse::parseWeather(jsonparse::jsonFromString(objectText));
+}
+
+bool WeatherFileIndex::openSidecar(const std::string& filename, std::ifstream& sidecar,
+        bool& file_sorted, std::uint64_t& entry_count) {
+    std::uint64_t currentSize;
+    std::int64_t currentTime;
+    if (!fileStamp(filename, currentSize, currentTime)) {
+        return false;
+    }
+
+    sidecar.open(sidecarFilename(filename), std::ios::binary);
+    if (!sidecar) {
+        return false;
+    }
+
+    char magic[sizeof(SidecarMagic)];
+    std::uint32_t version;
+    std::uint64_t fileSize;
+    std::int64_t fileTime;
+    std::uint8_t fileSorted;
+    if (!sidecar.read(magic, sizeof(magic))
+            || !std::equal(magic, magic + sizeof(magic), SidecarMagic)
+            || !readValue(sidecar, version) || version != SidecarVersion
+            || !readValue(sidecar, fileSize) || fileSize != currentSize
+            || !readValue(sidecar, fileTime) || fileTime != currentTime
+            || !readValue(sidecar, fileSorted)
+            || !readValue(sidecar, entry_count)
+            || entry_count > fileSize) { // each entry is at least 2 bytes of JSON
+        return false;
+    }
+
+    file_sorted = fileSorted != 0;
+    return true;
+}
+
+bool WeatherFileIndex::fileStamp(const std::string& filename,
+        std::uint64_t& size, std::int64_t& modified_time) {
+    std::error_code error;
+    size = std::filesystem::file_size(filename, error);
+    if (error) {
+        return false;
+    }
+
+    const auto writeTime = std::filesystem::last_write_time(filename, error);
+    if (error) {
+        return false;
+    }
+    modified_time = writeTime.time_since_epoch().count();
+
+    return true;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file weather_stream_reader.cpp
+ * @date 10/16/2026
+ *
+ * @brief WeatherStreamReader class definition
+ */
+
+#include "weather_stream_reader.h"
+#include "json_object_scanner.h"
+#include "json_parse.h"
+
+#include <string>
+
+WeatherStreamReader::WeatherStreamReader(std::istream& input, const bool sorted) :
+    mInput(input),
+    mSorted(sorted) {}
+
+std::size_t WeatherStreamReader::readRange(
+        const WeatherData::data_time begin_sec,
+        const WeatherData::data_time end_sec,
+        const std::function<void(const WeatherData&)>& visitor) {
+    jsonparse::JsonObjectScanner scanner(mInput);
+    std::string objectText;
+    std::uint64_t offset;
+    std::size_t visitCount = 0;
+    while (scanner.next(objectText, offset)) {
+        // filter on the date before parsing the whole object
+        const auto time = jsonparse::JsonObjectScanner::findDate(objectText);
+        if (!time.has_value() || time.value() < begin_sec) {
+            continue;
+        } else if (time.value() > end_sec) {
+            if (mSorted) {
+                break; // the rest of the stream is also past the range
+            }
+            continue;
+        }
+
+        visitor(jsonparse::parseWeather(jsonparse::jsonFromString(objectText)));
+        ++visitCount;
+    }
+
+    return visitCount;
+}
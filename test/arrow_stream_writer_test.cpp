@@ -0,0 +1,244 @@
+/**
+ * @file arrow_stream_writer_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for ArrowStreamWriter class
+ */
+
+#include "arrow_stream_writer.h"
+#include "json_parse.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /** @brief The metadata and body of an IPC message */
+    struct Message {
+        std::string metadata; /**<@brief FlatBuffers encoded Message table */
+        std::string body; /**<@brief Buffers of the message */
+        std::size_t root; /**<@brief Position of the Message table within metadata */
+    };
+
+    template <typename T>
+    T readValue(const std::string& bytes, const std::size_t position) {
+        T value;
+        std::memcpy(&value, bytes.data() + position, sizeof(T));
+        return value;
+    }
+
+    /** @brief Position of a field of a FlatBuffers table, 0 if the field is absent */
+    std::size_t field(const std::string& buffer, const std::size_t table, const std::size_t slot) {
+        const auto vtable = table - readValue<std::int32_t>(buffer, table);
+        if (4 + 2 * slot >= readValue<std::uint16_t>(buffer, vtable)) {
+            return 0;
+        }
+        const auto offset = readValue<std::uint16_t>(buffer, vtable + 4 + 2 * slot);
+        return offset == 0 ? 0 : table + offset;
+    }
+
+    /** @brief Position of the object referenced by a FlatBuffers offset */
+    std::size_t follow(const std::string& buffer, const std::size_t position) {
+        return position + readValue<std::uint32_t>(buffer, position);
+    }
+
+    /** @brief Split an IPC stream into its messages, checking the framing */
+    std::vector<Message> readMessages(const std::string& stream) {
+        std::vector<Message> messages;
+        std::size_t position = 0;
+        while (true) {
+            EXPECT_EQ(readValue<std::uint32_t>(stream, position), 0xFFFFFFFF) << "Missing continuation";
+            const auto size = static_cast<std::size_t>(readValue<std::int32_t>(stream, position + 4));
+            position += 8;
+            if (size == 0) {
+                break; // end of stream
+            }
+            EXPECT_EQ(size % 8, 0) << "Metadata is not padded";
+
+            Message message;
+            message.metadata = stream.substr(position, size);
+            message.root = follow(message.metadata, 0);
+            position += size;
+            const auto bodyLength = readValue<std::int64_t>(
+                    message.metadata, field(message.metadata, message.root, 3));
+            EXPECT_EQ(bodyLength % 8, 0) << "Body is not padded";
+            message.body = stream.substr(position, static_cast<std::size_t>(bodyLength));
+            position += static_cast<std::size_t>(bodyLength);
+            messages.push_back(message);
+        }
+        EXPECT_EQ(position, stream.size()) << "Data after the end of stream";
+        return messages;
+    }
+
+    /** @brief The length, null counts, and buffers of a record batch message */
+    struct Batch {
+        std::int64_t length;
+        std::vector<std::int64_t> nullCounts;
+        std::vector<std::string> buffers;
+    };
+
+    Batch readBatch(const Message& message) {
+        const auto& metadata = message.metadata;
+        EXPECT_EQ(readValue<std::uint8_t>(metadata, field(metadata, message.root, 1)), 3)
+            << "Not a record batch";
+        const auto batch = follow(metadata, field(metadata, message.root, 2));
+
+        Batch result;
+        result.length = readValue<std::int64_t>(metadata, field(metadata, batch, 0));
+        const auto nodes = follow(metadata, field(metadata, batch, 1));
+        for (std::uint32_t i = 0; i < readValue<std::uint32_t>(metadata, nodes); i++) {
+            EXPECT_EQ(readValue<std::int64_t>(metadata, nodes + 4 + 16 * i), result.length);
+            result.nullCounts.push_back(readValue<std::int64_t>(metadata, nodes + 4 + 16 * i + 8));
+        }
+        const auto buffers = follow(metadata, field(metadata, batch, 2));
+        for (std::uint32_t i = 0; i < readValue<std::uint32_t>(metadata, buffers); i++) {
+            const auto offset = readValue<std::int64_t>(metadata, buffers + 4 + 16 * i);
+            const auto length = readValue<std::int64_t>(metadata, buffers + 4 + 16 * i + 8);
+            EXPECT_EQ(offset % 8, 0) << "Buffer is not aligned";
+            result.buffers.push_back(message.body.substr(
+                        static_cast<std::size_t>(offset), static_cast<std::size_t>(length)));
+        }
+        return result;
+    }
+
+    bool bitSet(const std::string& bitmap, const std::size_t row) {
+        return (static_cast<std::uint8_t>(bitmap[row / 8]) >> (row % 8)) & 1;
+    }
+}
+
+/**
+ * @class ArrowStreamWriterTest arrow_stream_writer_test.cpp "test/arrow_stream_writer_test.cpp"
+ * @brief This class tests writing weather data as an Arrow IPC stream
+ */
+class ArrowStreamWriterTest : public ::testing::Test {
+protected:
+
+    ArrowStreamWriterTest() {}
+
+    ~ArrowStreamWriterTest() override {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+}; // ArrowStreamWriterTest
+
+/** @brief Test the schema message, and a stream without data */
+TEST_F(ArrowStreamWriterTest, Schema) {
+    std::ostringstream out;
+    ArrowStreamWriter writer(out);
+    writer.close();
+
+    const auto messages = readMessages(out.str());
+    ASSERT_EQ(messages.size(), 1) << "Only the schema should be written";
+    const auto& metadata = messages[0].metadata;
+    ASSERT_EQ(readValue<std::int16_t>(metadata, field(metadata, messages[0].root, 0)), 4)
+        << "Metadata version should be V5";
+    ASSERT_EQ(readValue<std::uint8_t>(metadata, field(metadata, messages[0].root, 1)), 1)
+        << "Not a schema";
+
+    const auto schema = follow(metadata, field(metadata, messages[0].root, 2));
+    const auto fields = follow(metadata, field(metadata, schema, 1));
+    const std::vector<std::string> names{jsonparse::DATE_KEY, jsonparse::PPT_KEY,
+        jsonparse::TMAX_KEY, jsonparse::TMEAN_KEY, jsonparse::TMIN_KEY};
+    ASSERT_EQ(readValue<std::uint32_t>(metadata, fields), names.size());
+    for (std::size_t i = 0; i < names.size(); i++) {
+        const auto fieldTable = follow(metadata, fields + 4 + 4 * i);
+        const auto name = follow(metadata, field(metadata, fieldTable, 0));
+        ASSERT_EQ(metadata.substr(name + 4, readValue<std::uint32_t>(metadata, name)), names[i]);
+        ASSERT_EQ(readValue<std::uint8_t>(metadata, field(metadata, fieldTable, 1)), 1)
+            << "Columns should be nullable";
+
+        // date32 (Date with unit DAY) or float32 (FloatingPoint with precision SINGLE)
+        const auto type = follow(metadata, field(metadata, fieldTable, 3));
+        ASSERT_EQ(readValue<std::uint8_t>(metadata, field(metadata, fieldTable, 2)), i == 0 ? 8 : 3);
+        ASSERT_EQ(readValue<std::int16_t>(metadata, field(metadata, type, 0)), i == 0 ? 0 : 1);
+        ASSERT_EQ(readValue<std::uint32_t>(metadata, follow(metadata, field(metadata, fieldTable, 5))), 0)
+            << "Columns should have no children";
+    }
+}
+
+/** @brief Test writing data points with missing data */
+TEST_F(ArrowStreamWriterTest, WriteData) {
+    std::vector<WeatherData> data(3);
+    data[0].time = jsonparse::dateToUnix("2016-01-01").value();
+    data[0].maxTemp = 12.5f;
+    data[0].gas_ppt = 0.0f;
+    data[1].time = jsonparse::dateToUnix("1969-12-31").value();
+    data[1].minTemp = -3.25f;
+    data[2].maxTemp = 7.0f; // no date
+
+    std::ostringstream out;
+    ArrowStreamWriter writer(out);
+    for (const auto& point : data) {
+        writer.write(point);
+    }
+    writer.close();
+
+    const auto messages = readMessages(out.str());
+    ASSERT_EQ(messages.size(), 2);
+    const auto batch = readBatch(messages[1]);
+    ASSERT_EQ(batch.length, 3);
+    ASSERT_EQ(batch.nullCounts, (std::vector<std::int64_t>{1, 2, 1, 3, 2}));
+    ASSERT_EQ(batch.buffers.size(), 10) << "Each column should have a bitmap and values";
+
+    // date
+    ASSERT_TRUE(bitSet(batch.buffers[0], 0));
+    ASSERT_TRUE(bitSet(batch.buffers[0], 1));
+    ASSERT_FALSE(bitSet(batch.buffers[0], 2));
+    ASSERT_EQ(batch.buffers[1].size(), 3 * sizeof(std::int32_t));
+    ASSERT_EQ(readValue<std::int32_t>(batch.buffers[1], 0), 16801);
+    ASSERT_EQ(readValue<std::int32_t>(batch.buffers[1], 4), -1);
+
+    // tmax
+    ASSERT_TRUE(bitSet(batch.buffers[4], 0));
+    ASSERT_FALSE(bitSet(batch.buffers[4], 1));
+    ASSERT_TRUE(bitSet(batch.buffers[4], 2));
+    ASSERT_FLOAT_EQ(readValue<float>(batch.buffers[5], 0), 12.5f);
+    ASSERT_FLOAT_EQ(readValue<float>(batch.buffers[5], 8), 7.0f);
+
+    // tmin
+    ASSERT_TRUE(bitSet(batch.buffers[8], 1));
+    ASSERT_FLOAT_EQ(readValue<float>(batch.buffers[9], 4), -3.25f);
+}
+
+/** @brief Test writing data from column storage, split into record batches */
+TEST_F(ArrowStreamWriterTest, WriteColumns) {
+    const auto firstDay = jsonparse::dateToUnix("2000-01-01").value();
+    std::vector<WeatherData> data(ArrowStreamWriter::BatchSize + 100);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i].time = firstDay + static_cast<WeatherData::data_time>(i) * WeatherData::DaySeconds;
+        if (i % 10 != 0) {
+            data[i].meanTemp = static_cast<float>(i) / 8.0f;
+        }
+    }
+    const WeatherColumns columns(data);
+
+    std::ostringstream out;
+    ArrowStreamWriter writer(out);
+    writer.write(data[0]); // held data is written before the columns
+    writer.write(columns, 50, data.size());
+    writer.close();
+
+    const auto messages = readMessages(out.str());
+    ASSERT_EQ(messages.size(), 4) << "Expected the schema and three record batches";
+    ASSERT_EQ(readBatch(messages[1]).length, 1);
+    ASSERT_EQ(readBatch(messages[2]).length, ArrowStreamWriter::BatchSize);
+
+    const auto last = readBatch(messages[3]);
+    ASSERT_EQ(last.length, 50);
+    ASSERT_EQ(last.nullCounts[0], 0);
+    ASSERT_EQ(last.nullCounts[3], 5) << "Every 10th tmean is missing";
+    for (std::size_t row = 0; row < 50; row++) {
+        const auto i = 50 + ArrowStreamWriter::BatchSize + row;
+        ASSERT_EQ(readValue<std::int32_t>(last.buffers[1], 4 * row), 10957 + static_cast<std::int32_t>(i));
+        ASSERT_EQ(bitSet(last.buffers[6], row), i % 10 != 0);
+        if (i % 10 != 0) {
+            ASSERT_FLOAT_EQ(readValue<float>(last.buffers[7], 4 * row), static_cast<float>(i) / 8.0f);
+        }
+    }
+}
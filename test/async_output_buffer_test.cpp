@@ -0,0 +1,83 @@
+/**
+ * @file async_output_buffer_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for AsyncOutputBuffer class
+ */
+
+#include "async_output_buffer.h"
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @class AsyncOutputBufferTest async_output_buffer_test.cpp "test/async_output_buffer_test.cpp"
+ * @brief This class tests writing output from a dedicated writer thread
+ */
+class AsyncOutputBufferTest : public ::testing::Test {
+protected:
+
+    AsyncOutputBufferTest() {}
+
+    ~AsyncOutputBufferTest() override {}
+
+    void SetUp() override {
+        mpFile = std::tmpfile();
+        ASSERT_NE(mpFile, nullptr) << "Unable to create a temporary file";
+    }
+
+    void TearDown() override {
+        std::fclose(mpFile);
+    }
+
+    /** @brief Read everything that was written to the temporary file */
+    std::string readFile() {
+        std::string contents;
+        std::rewind(mpFile);
+        char buffer[4096];
+        std::size_t count;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), mpFile)) > 0) {
+            contents.append(buffer, count);
+        }
+        return contents;
+    }
+
+    std::FILE* mpFile {nullptr}; /**<@brief Temporary file written to */
+
+}; // AsyncOutputBufferTest
+
+/** @brief Test that output spanning many blocks is written completely and in order */
+TEST_F(AsyncOutputBufferTest, WriteBlocks) {
+    std::ostringstream expected;
+    {
+        // small blocks, so most lines cross a block boundary
+        AsyncOutputBuffer buffer(fileno(mpFile), 64, 2);
+        std::ostream out(&buffer);
+        for (auto i = 0; i < 20000; ++i) {
+            out << "line " << i << ": " << std::string(static_cast<std::size_t>(i % 200), 'x') << "\n";
+            expected << "line " << i << ": " << std::string(static_cast<std::size_t>(i % 200), 'x') << "\n";
+            if (i % 5000 == 0) {
+                out.flush();
+                ASSERT_TRUE(out.good());
+                ASSERT_EQ(readFile(), expected.str()) << "Flushed output was not written";
+                std::fseek(mpFile, 0, SEEK_END);
+            }
+        }
+        ASSERT_TRUE(out.good());
+    } // the destructor writes the remaining output
+
+    ASSERT_EQ(readFile(), expected.str());
+}
+
+/** @brief Test that a failed write fails the stream */
+TEST_F(AsyncOutputBufferTest, WriteFailure) {
+    AsyncOutputBuffer buffer(-1, 16, 2); // not a file descriptor
+    std::ostream out(&buffer);
+    out << "some output";
+    ASSERT_TRUE(out.good()) << "Output should be held until a block is full";
+    out.flush();
+    ASSERT_TRUE(out.bad()) << "The failed write should fail the stream";
+}
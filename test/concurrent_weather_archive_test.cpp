@@ -0,0 +1,118 @@
+/**
+ * @file concurrent_weather_archive_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for ConcurrentWeatherArchive class
+ */
+
+#include "data/weather_data.h"
+#include "data/concurrent_weather_archive.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ConcurrentWeatherArchiveTest concurrent_weather_archive_test.cpp "test/concurrent_weather_archive_test.cpp"
+ * @brief This class tests adding and retrieving data from ConcurrentWeatherArchive
+ */
+class ConcurrentWeatherArchiveTest : public ::testing::Test {
+protected:
+
+    ConcurrentWeatherArchiveTest() {}
+
+    ~ConcurrentWeatherArchiveTest() override {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    /** @brief Create a data point whose values are derived from its time */
+    static WeatherData createData(const WeatherData::data_time time) {
+        WeatherData data;
+        data.time = time;
+        data.maxTemp = static_cast<float>(time);
+        data.minTemp = -static_cast<float>(time);
+        return data;
+    }
+
+}; // ConcurrentWeatherArchiveTest
+
+/** @brief Test that added data is only visible once it is published */
+TEST_F(ConcurrentWeatherArchiveTest, Publish) {
+    ConcurrentWeatherArchive archive(WeatherArchive(), 3);
+    const auto initialSnapshot = archive.snapshot();
+
+    archive.addData(createData(0));
+    archive.addData(createData(1));
+    ASSERT_FALSE(archive.retrieve(0).has_value()) << "Pending data should not be visible";
+    ASSERT_EQ(archive.version(), 0);
+
+    archive.addData(createData(2)); // fills the batch
+    ASSERT_EQ(archive.version(), 1);
+    ASSERT_EQ(archive.retrieveRange(0, 2).size(), 3) << "A full batch was not published";
+
+    archive.addData(createData(3));
+    archive.publish();
+    ASSERT_EQ(archive.version(), 2);
+    ASSERT_TRUE(archive.retrieve(3).has_value()) << "publish did not publish pending data";
+
+    archive.publish(); // nothing pending
+    ASSERT_EQ(archive.version(), 2) << "A version was published without pending data";
+
+    ASSERT_EQ(initialSnapshot->size(), 0) << "A snapshot changed after it was taken";
+}
+
+/** @brief Stress test readers retrieving data while a writer adds data */
+TEST_F(ConcurrentWeatherArchiveTest, ConcurrentReadWrite) {
+    const int DataLength = 20000;
+    const int ReaderCount = 4;
+
+    ConcurrentWeatherArchive archive(WeatherArchive(), 64);
+    std::atomic<bool> writing {true};
+    std::atomic<int> failures {0};
+
+    std::vector<std::thread> readers;
+    for (auto r = 0; r < ReaderCount; ++r) {
+        readers.emplace_back([&]() {
+            std::size_t lastSize = 0;
+            while (writing.load()) {
+                // data is added in time order, so every snapshot holds times [0, size)
+                const auto snapshot = archive.snapshot();
+                const auto size = snapshot->size();
+                if (size < lastSize) {
+                    ++failures; // versions must not go backwards
+                }
+                lastSize = size;
+
+                if (size > 0) {
+                    const auto last = static_cast<WeatherData::data_time>(size - 1);
+                    const auto dataOpt = snapshot->retrieve(last);
+                    if (!dataOpt.has_value() || dataOpt.value() != createData(last)) {
+                        ++failures;
+                    }
+                    if (snapshot->retrieveRange(0, last).size() != size) {
+                        ++failures;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto i = 0; i < DataLength; ++i) {
+        archive.addData(createData(i));
+    }
+    archive.publish();
+    writing = false;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0) << "Readers observed an inconsistent version of the archive";
+    ASSERT_EQ(archive.snapshot()->size(), DataLength) << "Not all data was published";
+    for (auto i = 0; i < DataLength; ++i) {
+        ASSERT_EQ(archive.retrieve(i).value(), createData(i));
+    }
+}
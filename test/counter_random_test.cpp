@@ -0,0 +1,70 @@
+/**
+ * @file counter_random_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for CounterRandom class
+ */
+
+#include "data/counter_random.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+/**
+ * @class CounterRandomTest counter_random_test.cpp "test/counter_random_test.cpp"
+ * @brief This class tests the Philox4x32-10 counter based random number generator
+ */
+class CounterRandomTest : public ::testing::Test {
+protected:
+
+    CounterRandomTest() {}
+
+    ~CounterRandomTest() override {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+}; // CounterRandomTest
+
+/**
+ * @brief Test the Philox4x32-10 known answers of Random123 (kat_vectors). The counter
+ * words are the low and high words of the counter, then of the stream, and the key
+ * words are the low and high words of the seed
+ */
+TEST_F(CounterRandomTest, KnownAnswers) {
+    // zero counter and key
+    ASSERT_EQ(CounterRandom(0).generate(0, 0),
+            (CounterRandom::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+
+    // all ones counter and key
+    ASSERT_EQ(CounterRandom(UINT64_MAX).generate(UINT64_MAX, UINT64_MAX),
+            (CounterRandom::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+
+    // digits of pi, which checks the order of the counter and key words
+    ASSERT_EQ(CounterRandom(0x299f31d0a4093822).generate(0x85a308d3243f6a88, 0x0370734413198a2e),
+            (CounterRandom::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+/** @brief Test that a draw depends only on the seed, counter, and stream */
+TEST_F(CounterRandomTest, Independence) {
+    const CounterRandom random(42);
+    ASSERT_EQ(random.generate(7, 3), CounterRandom(42).generate(7, 3));
+    ASSERT_NE(random.generate(7, 3), random.generate(8, 3));
+    ASSERT_NE(random.generate(7, 3), random.generate(7, 4));
+    ASSERT_NE(random.generate(7, 3), CounterRandom(43).generate(7, 3));
+    ASSERT_EQ(random.seed(), 42);
+}
+
+/** @brief Test scaling random bits to [0, n) */
+TEST_F(CounterRandomTest, Uniform) {
+    ASSERT_EQ(CounterRandom::scale(0, 10), 0);
+    ASSERT_EQ(CounterRandom::scale(UINT32_MAX, 10), 9);
+    ASSERT_EQ(CounterRandom::scale(0x80000000, 10), 5);
+
+    const CounterRandom random(42);
+    for (std::uint64_t counter = 0; counter < 1000; ++counter) {
+        ASSERT_LT(random.uniform(counter, 7), 7);
+        ASSERT_EQ(random.uniform(counter, 7), CounterRandom::scale(random.generate(counter)[0], 7));
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file input_paths_test.cpp
+ * @date 10/17/2026
+ *
+ * @brief Unit test for resolving weather data input paths within the inputpaths namespace
+ */
+
+#include "input_paths.h"
+#include "json_parse.h"
+#include "data/weather_archive.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /** @brief Create a file containing a string, and any missing parent directories */
+    void writeFile(const std::filesystem::path& path, const std::string& contents) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << contents;
+    }
+
+    /** @brief Create an empty temporary directory for a test */
+    std::filesystem::path createTestDirectory(const std::string& name) {
+        const auto directory = std::filesystem::temp_directory_path() / ("input_paths_test_" + name);
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+}
+
+/**
+ * @class InputPathsTest input_paths_test.cpp "test/input_paths_test.cpp"
+ * @brief This class tests the expansion of directories and glob patterns into files
+ */
+class InputPathsTest : public ::testing::Test {
+protected:
+
+    InputPathsTest() {}
+
+    ~InputPathsTest() override {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+}; // InputPathsTest
+
+/** @brief Test expanding directories and glob patterns, and the precedence of the files */
+TEST_F(InputPathsTest, ExpandInputPaths) {
+    const auto directory = createTestDirectory("ExpandInputPaths");
+    writeFile(directory / "data" / "2016.json", "[{\"date\": \"2016-12-31\", \"tmax\": 1.0}]");
+    writeFile(directory / "data" / "2015.json",
+            "[{\"date\": \"2015-12-31\", \"tmax\": 1.0}, {\"date\": \"2016-12-31\", \"tmax\": 2.0}]");
+    writeFile(directory / "data" / "notes.txt", "not weather data");
+    writeFile(directory / "data" / "nested" / "2014.json", "[]");
+    writeFile(directory / "extra.json", "{\"date\": \"2016-12-31\", \"tmax\": 3.0}");
+    std::filesystem::create_directories(directory / "empty");
+
+    // directories are replaced by their .json files in filename order, files are kept as is
+    const auto dataDirectory = (directory / "data").string();
+    const auto extraFile = (directory / "extra.json").string();
+    const auto filenames = inputpaths::expandInputPaths({dataDirectory, extraFile});
+    ASSERT_EQ(filenames, (std::vector<std::string>{
+                (directory / "data" / "2015.json").string(),
+                (directory / "data" / "2016.json").string(),
+                extraFile}));
+
+    // glob patterns are replaced by their matches in sorted order
+    ASSERT_EQ(inputpaths::expandInputPaths({(directory / "data" / "20*.json").string()}),
+            (std::vector<std::string>{
+                (directory / "data" / "2015.json").string(),
+                (directory / "data" / "2016.json").string()}));
+
+    ASSERT_THROW(inputpaths::expandInputPaths({(directory / "empty").string()}), inputpaths::InputPathError)
+        << "A directory without .json files should be an error";
+    ASSERT_THROW(inputpaths::expandInputPaths({(directory / "*.csv").string()}), inputpaths::InputPathError)
+        << "A pattern without matches should be an error";
+
+    // the data of a date in several files is taken from the file listed last
+    WeatherArchive archive;
+    for (const auto& filename : filenames) {
+        archive.addBatch(jsonparse::parseWeatherFile(filename));
+    }
+    ASSERT_EQ(archive.size(), 2);
+    ASSERT_FLOAT_EQ(archive.retrieve(jsonparse::dateToUnix("2016-12-31").value())->maxTemp.value(), 3.0f);
+
+    std::filesystem::remove_all(directory);
+}
@@ -6,12 +6,35 @@
  */
 
 #include "json_parse.h"
+#include "data/weather_columns.h"
 #include "data/weather_data.h"
+#include "date/date.h"
 
 #include <gtest/gtest.h>
 #include <string>
 #include <cmath>
 #include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+    /** @brief Create a file containing a string, and any missing parent directories */
+    void writeFile(const std::filesystem::path& path, const std::string& contents) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << contents;
+    }
+
+    /** @brief Create an empty temporary directory for a test */
+    std::filesystem::path createTestDirectory(const std::string& name) {
+        const auto directory = std::filesystem::temp_directory_path() / ("json_parse_test_" + name);
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+}
 
 /**
  * @class PayloadParserTest json_parse_test.cpp "test/json_parse_test.cpp"
@@ -48,6 +71,33 @@ TEST_F(PayloadParserTest, ParseValidWeatherData) {
     }) << "Exception thrown parsing valid weather data";
 }
 
+/** @brief Test reading files with an array of weather data, a single object, or no file */
+TEST_F(PayloadParserTest, ParseWeatherFile) {
+    const auto directory = createTestDirectory("ParseWeatherFile");
+    writeFile(directory / "array.json",
+            "[{\"date\": \"2016-03-02\", \"tmax\": 2.0},"
+            "{\"date\": \"2016-03-01\", \"tmax\": 1.0, \"ppt\": 0.5}]");
+    writeFile(directory / "object.json", "{\"date\": \"2016-03-03\", \"tmin\": -3.0}");
+    writeFile(directory / "invalid.json", "[{\"date\": \"2016-03-03\", ");
+
+    const auto arrayData = jsonparse::parseWeatherFile((directory / "array.json").string());
+    ASSERT_EQ(arrayData.size(), 2);
+    ASSERT_EQ(arrayData[0].time.value(), jsonparse::dateToUnix("2016-03-02").value())
+        << "Data should be returned in file order";
+    ASSERT_FLOAT_EQ(arrayData[0].maxTemp.value(), 2.0f);
+    ASSERT_FLOAT_EQ(arrayData[1].gas_ppt.value(), 0.5f);
+
+    const auto objectData = jsonparse::parseWeatherFile((directory / "object.json").string());
+    ASSERT_EQ(objectData.size(), 1);
+    ASSERT_FLOAT_EQ(objectData[0].minTemp.value(), -3.0f);
+    ASSERT_FALSE(objectData[0].maxTemp.has_value());
+
+    ASSERT_THROW(jsonparse::parseWeatherFile((directory / "missing.json").string()), jsonparse::IncorrectJson);
+    ASSERT_THROW(jsonparse::parseWeatherFile((directory / "invalid.json").string()), jsonparse::IncorrectJson);
+
+    std::filesystem::remove_all(directory);
+}
+
 /** @brief Test the parsing of weather data that has extra whitespace in the date */
 TEST_F(PayloadParserTest, ParseInvalidDate) {
     const std::string invalidDate{
@@ -109,6 +159,31 @@ TEST_F(PayloadParserTest, DateToUnixConversion) {
         << "Date string -> Unix time -> Date string conversion failed";
 }
 
+/** @brief Test the integer date formatter against the date library, for every day from
+ * 1600 to 2400 (covering century and 400 year leap rules) and times within a day */
+TEST_F(PayloadParserTest, FormatDate) {
+    const auto first = date::sys_days{date::year{1600}/1/1}.time_since_epoch().count();
+    const auto last = date::sys_days{date::year{2400}/12/31}.time_since_epoch().count();
+    for (auto day = first; day <= last; ++day) {
+        const date::year_month_day ymd{date::sys_days{date::days{day}}};
+        std::ostringstream expected;
+        expected << ymd;
+
+        for (const auto second : {0, 1, 86399}) {
+            char buffer[jsonparse::DateLength];
+            ASSERT_TRUE(jsonparse::formatDate(day * WeatherData::DaySeconds + second, buffer));
+            ASSERT_EQ(std::string(buffer, jsonparse::DateLength), expected.str());
+        }
+    }
+
+    // years that are not 4 digits are not written, unixToDate still formats them
+    char buffer[jsonparse::DateLength];
+    const auto farFuture = date::sys_days{date::year{10000}/1/1}.time_since_epoch().count() * WeatherData::DaySeconds;
+    ASSERT_FALSE(jsonparse::formatDate(farFuture, buffer));
+    ASSERT_TRUE(jsonparse::formatDate(farFuture - 1, buffer));
+    ASSERT_EQ(jsonparse::unixToDate(farFuture), "10000-01-01");
+}
+
 /** @brief Test creating a JSON schema from a WeatherData object */
 TEST_F(PayloadParserTest, CreateWeatherJson) {
     WeatherData data;
@@ -153,3 +228,168 @@ TEST_F(PayloadParserTest, CreateWeatherJson) {
     ASSERT_FLOAT_EQ(schema[jsonparse::PPT_KEY].asFloat(), data.gas_ppt.value())
         << jsonparse::PPT_KEY << " key's value was not set correctly";
 }
+
+/** @brief Test that JsonArrayWriter matches the output of jsonPretty for the whole array */
+TEST_F(PayloadParserTest, JsonArrayWriter) {
+    Json::Value array = Json::arrayValue;
+    std::ostringstream emptyOut;
+    jsonparse::JsonArrayWriter emptyWriter(emptyOut);
+    emptyWriter.close();
+    ASSERT_EQ(emptyOut.str(), jsonparse::jsonPretty(array)) << "Empty array output does not match";
+
+    std::ostringstream out;
+    jsonparse::JsonArrayWriter writer(out);
+    for (auto i = 0; i < 3; ++i) {
+        WeatherData data;
+        data.time = i * WeatherData::DaySeconds;
+        data.maxTemp = 12.345f + i;
+        data.gas_ppt = 0.0f;
+        array.append(jsonparse::createWeatherJson(data));
+        writer.write(array[i]);
+    }
+    writer.close();
+
+    ASSERT_EQ(out.str(), jsonparse::jsonPretty(array)) << "Array output does not match";
+}
+
+/** @brief Test that formatNumber writes numbers the same as jsonPretty, for the millidegree
+ * and precipitation values of weather data and for doubles of every magnitude */
+TEST_F(PayloadParserTest, FormatNumber) {
+    char buffer[jsonparse::NumberBufferSize];
+    const auto expectSame = [&](const double value) {
+        const auto size = jsonparse::formatNumber(value, buffer);
+        ASSERT_EQ(std::string(buffer, size), jsonparse::jsonPretty(Json::Value(value)))
+            << "for " << std::hexfloat << value;
+    };
+
+    for (auto milli = -60000; milli <= 60000; ++milli) {
+        expectSame(static_cast<float>(milli) / 1000.0f);
+    }
+    for (auto centi = 0; centi <= 100000; ++centi) {
+        expectSame(static_cast<float>(centi) / 100.0f);
+    }
+    for (const auto value : {0.0, -0.0, 1.0, -20.0, 999999.0, 1000000.0, 1234567.0, 1e-4, 9.99999e-5,
+            0.1, 1e21, -1e-300, 5e-324, 1.7976931348623157e308, 10.03125, 0.0000125}) {
+        expectSame(value);
+    }
+
+    std::mt19937_64 generator(0);
+    for (auto i = 0; i < 100000; ++i) {
+        double value;
+        const auto bits = generator();
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value)) {
+            expectSame(value);
+        }
+    }
+}
+
+/** @brief Test that JsonArrayWriter writes weather data the same as its createWeatherJson */
+TEST_F(PayloadParserTest, JsonArrayWriterWeatherData) {
+    Json::Value array = Json::arrayValue;
+    std::ostringstream out;
+    std::ostringstream compactOut;
+    jsonparse::JsonArrayWriter writer(out);
+    jsonparse::JsonArrayWriter compactWriter(compactOut, true);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> milli(-50000, 50000);
+    for (auto i = 0; i < 1000; ++i) {
+        // every combination of missing variables, including none set, with and without
+        // a time (i % 32 == 16 has neither a time nor any values)
+        WeatherData data;
+        if (i % 32 != 31 && i % 32 != 16) {
+            data.time = static_cast<WeatherData::data_time>(i) * WeatherData::DaySeconds * 37;
+        }
+        if (i & 1) {
+            data.maxTemp = static_cast<float>(milli(generator)) / 1000.0f;
+        }
+        if (i & 2) {
+            data.minTemp = static_cast<float>(milli(generator)) / 1000.0f;
+        }
+        if (i & 4) {
+            data.meanTemp = static_cast<float>(milli(generator)) / 1000.0f;
+        }
+        if (i & 8) {
+            data.gas_ppt = static_cast<float>(std::abs(milli(generator))) / 100.0f;
+        }
+        array.append(jsonparse::createWeatherJson(data));
+        writer.write(data);
+        compactWriter.write(data);
+    }
+    writer.close();
+    compactWriter.close();
+
+    ASSERT_EQ(out.str(), jsonparse::jsonPretty(array)) << "Array output does not match";
+    ASSERT_EQ(compactOut.str(), jsonparse::jsonCompact(array)) << "Compact array output does not match";
+
+    // compact elements that are not weather data, and an empty array
+    std::ostringstream summaryOut;
+    jsonparse::JsonArrayWriter summaryWriter(summaryOut, true);
+    Json::Value summaryArray = Json::arrayValue;
+    for (auto i = 0; i < 3; ++i) {
+        Json::Value summary;
+        summary[jsonparse::PERIOD_KEY] = "2016-0" + std::to_string(i + 1);
+        summary[jsonparse::COUNT_KEY] = i;
+        summary[jsonparse::MEAN_KEY] = 1.5 * i;
+        summaryArray.append(summary);
+        summaryWriter.write(summary);
+    }
+    summaryWriter.close();
+    ASSERT_EQ(summaryOut.str(), jsonparse::jsonCompact(summaryArray)) << "Compact array output does not match";
+
+    std::ostringstream emptyOut;
+    jsonparse::JsonArrayWriter emptyWriter(emptyOut, true);
+    emptyWriter.close();
+    ASSERT_EQ(emptyOut.str(), jsonparse::jsonCompact(Json::Value(Json::arrayValue)));
+}
+
+TEST_F(PayloadParserTest, WriteColumns) {
+    std::vector<WeatherData> data;
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> milli(-50000, 50000);
+    for (auto i = 0; i < 200; ++i) {
+        WeatherData point;
+        point.time = static_cast<WeatherData::data_time>(i) * WeatherData::DaySeconds;
+        if (i % 3 != 0) {
+            point.maxTemp = static_cast<float>(milli(generator)) / 1000.0f;
+        }
+        if (i % 5 != 0) {
+            point.minTemp = static_cast<float>(milli(generator)) / 1000.0f;
+        }
+        if (i % 7 != 0) {
+            point.meanTemp = static_cast<float>(milli(generator)) / 1000.0f;
+        }
+        point.gas_ppt = static_cast<float>(std::abs(milli(generator))) / 100.0f;
+        data.push_back(point);
+    }
+
+    // the object the columns should match, with null for missing data
+    const auto columnsJson = [&](const std::size_t first, const std::size_t last) {
+        Json::Value columns;
+        columns[jsonparse::DATE_KEY] = Json::arrayValue;
+        for (const auto& key : {jsonparse::PPT_KEY, jsonparse::TMAX_KEY,
+                jsonparse::TMEAN_KEY, jsonparse::TMIN_KEY}) {
+            columns[key] = Json::arrayValue;
+        }
+        for (auto i = first; i < last; ++i) {
+            const auto pointJson = jsonparse::createWeatherJson(data[i]);
+            for (const auto& key : columns.getMemberNames()) {
+                columns[key].append(pointJson.get(key, Json::Value()));
+            }
+        }
+        return jsonparse::jsonCompact(columns);
+    };
+
+    std::ostringstream out;
+    jsonparse::writeColumns(out, data);
+    ASSERT_EQ(out.str(), columnsJson(0, data.size())) << "Columns output does not match";
+
+    const WeatherColumns columns(data);
+    std::ostringstream rangeOut;
+    jsonparse::writeColumns(rangeOut, columns, 10, 150);
+    ASSERT_EQ(rangeOut.str(), columnsJson(10, 150)) << "Columns output of a range does not match";
+
+    std::ostringstream emptyOut;
+    jsonparse::writeColumns(emptyOut, columns, 20, 20);
+    ASSERT_EQ(emptyOut.str(), columnsJson(0, 0)) << "Empty columns output does not match";
+}
@@ -0,0 +1,89 @@
+/**
+ * @file thread_pool_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for ThreadPool class
+ */
+
+#include "thread_pool.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class ThreadPoolTest thread_pool_test.cpp "test/thread_pool_test.cpp"
+ * @brief This class tests running tasks on a pool of worker threads
+ */
+class ThreadPoolTest : public ::testing::Test {
+protected:
+
+    ThreadPoolTest() {}
+
+    ~ThreadPoolTest() override {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+}; // ThreadPoolTest
+
+/** @brief Test that tasks are run in the order they are submitted */
+TEST_F(ThreadPoolTest, RunInOrder) {
+    std::vector<int> order;
+    {
+        ThreadPool pool(1); // a single worker runs the tasks one at a time
+        ASSERT_EQ(pool.size(), 1);
+        for (auto i = 0; i < 100; ++i) {
+            pool.submit([&order, i]() { order.push_back(i); });
+        }
+    } // destroying the pool finishes the submitted tasks
+
+    ASSERT_EQ(order.size(), 100) << "Every task should run before the pool is destroyed";
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT_EQ(order[i], i) << "Tasks should run in submission order";
+    }
+}
+
+/** @brief Test the results returned through futures */
+TEST_F(ThreadPoolTest, FutureResults) {
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.size(), 4);
+    ASSERT_EQ(ThreadPool(0).size(), 1) << "A pool should have at least one worker";
+
+    std::vector<std::future<int>> results;
+    for (auto i = 0; i < 1000; ++i) {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+    for (auto i = 0; i < 1000; ++i) {
+        ASSERT_EQ(results[i].get(), i * i);
+    }
+
+    // an exception thrown by a task is rethrown by its future, and the worker keeps running
+    auto failed = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    ASSERT_THROW(failed.get(), std::runtime_error);
+    ASSERT_EQ(pool.submit([]() { return 7; }).get(), 7);
+}
+
+/** @brief Test that tasks run concurrently on multiple workers */
+TEST_F(ThreadPoolTest, RunConcurrently) {
+    ThreadPool pool(2);
+    std::promise<void> firstStarted;
+    auto firstStartedFuture = firstStarted.get_future();
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+
+    // the first task blocks until the second one runs, which needs a second worker
+    auto first = pool.submit([&firstStarted, releaseFuture]() {
+        firstStarted.set_value();
+        return releaseFuture.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+    });
+    firstStartedFuture.wait();
+    auto second = pool.submit([&release]() { release.set_value(); });
+
+    second.get();
+    ASSERT_TRUE(first.get()) << "The second task should run while the first is blocked";
+}
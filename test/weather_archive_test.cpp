@@ -8,7 +8,14 @@
 #include "data/weather_data.h"
 #include "data/weather_archive.h"
 
+#include "date/date.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <tuple>
+#include <vector>
 
 class WeatherArchiveTest : public ::testing::Test {
 protected:
@@ -21,6 +28,31 @@ protected:
 
     void TearDown() override {}
 
+    /**
+     * @brief Build an archive of evenly spaced data points, added with a single batch
+     * @param[in] count Number of data points
+     * @param[in] fill Function that sets the values of the data point at an index, whose
+     * time is already set. Clearing the time leaves the data point out of the archive
+     * @param[in] start_time Time of the first data point
+     * @param[in] step Seconds between data points, a day by default
+     * @return The archive
+     */
+    static WeatherArchive buildArchive(
+            const int count,
+            const std::function<void(int, WeatherData&)>& fill,
+            const WeatherData::data_time start_time = 0,
+            const WeatherData::data_time step = WeatherData::DaySeconds) {
+        std::vector<WeatherData> batch(static_cast<std::size_t>(count));
+        for (auto i = 0; i < count; ++i) {
+            batch[i].time = start_time + i * step;
+            fill(i, batch[i]);
+        }
+
+        WeatherArchive archive;
+        archive.addBatch(std::move(batch));
+        return archive;
+    }
+
 }; // WeatherArchiveTest
 
 
@@ -136,3 +168,714 @@ TEST_F(WeatherArchiveTest, RetrieveDataRange) {
         "WeatherArchive::retrieveRange returned " << retrieveRangeData.size() <<
         " data points when it should have not returned any points";
 }
+
+/** @brief Test adding data that is already sorted by time using WeatherArchive::addBatch */
+TEST_F(WeatherArchiveTest, AddBatchSorted) {
+    const int BatchLength = 10;
+
+    std::vector<WeatherData> batch;
+    for (auto i = 0; i < BatchLength; ++i) {
+        WeatherData newData;
+        newData.time = i;
+        newData.maxTemp = i + 0.5f;
+        batch.push_back(newData);
+    }
+    const auto expectedData = batch;
+
+    WeatherArchive archive;
+    archive.addBatch(std::move(batch));
+    ASSERT_EQ(archive.size(), BatchLength) << "WeatherArchive::addBatch did not add all data";
+
+    // a second sorted batch that begins after the first is appended
+    WeatherData laterData;
+    laterData.time = BatchLength;
+    laterData.minTemp = 1.0f;
+    archive.addBatch(std::vector<WeatherData>{laterData});
+    ASSERT_EQ(archive.size(), BatchLength + 1) << "WeatherArchive::addBatch did not append data";
+
+    const auto retrieveRangeData = archive.retrieveRange(0, BatchLength);
+    ASSERT_EQ(retrieveRangeData.size(), BatchLength + 1);
+    for (auto i = 0; i < BatchLength; ++i) {
+        ASSERT_EQ(retrieveRangeData[i], expectedData[i])
+            << "Retrieved data does not match the data that was added";
+    }
+    ASSERT_EQ(retrieveRangeData.back(), laterData)
+        << "Retrieved data does not match the data that was appended";
+}
+
+/** @brief Test adding unsorted data with duplicate and missing timestamps using WeatherArchive::addBatch */
+TEST_F(WeatherArchiveTest, AddBatchUnsorted) {
+    WeatherArchive archive;
+
+    // existing data that partially overlaps the batch
+    for (auto i = 0; i < 6; i += 2) {
+        WeatherData existingData;
+        existingData.time = i;
+        existingData.maxTemp = 100.0f;
+        archive.addData(existingData);
+    }
+
+    std::vector<WeatherData> batch;
+    for (const auto time : {5, 1, 2, 5, 3}) {
+        WeatherData newData;
+        newData.time = time;
+        newData.maxTemp = static_cast<float>(batch.size());
+        batch.push_back(newData);
+    }
+    batch.push_back(WeatherData{}); // no timestamp, must be ignored
+
+    // iterator range overload
+    archive.addBatch(batch.cbegin(), batch.cend());
+
+    // times 0 through 5 are present, 0 and 4 come from the existing data
+    ASSERT_EQ(archive.size(), 6) << "WeatherArchive::addBatch did not merge the data correctly";
+    ASSERT_FLOAT_EQ(archive.retrieve(0).value().maxTemp.value(), 100.0f);
+    ASSERT_FLOAT_EQ(archive.retrieve(1).value().maxTemp.value(), 1.0f);
+    ASSERT_FLOAT_EQ(archive.retrieve(2).value().maxTemp.value(), 2.0f)
+        << "Batch data did not replace the existing data";
+    ASSERT_FLOAT_EQ(archive.retrieve(3).value().maxTemp.value(), 4.0f);
+    ASSERT_FLOAT_EQ(archive.retrieve(4).value().maxTemp.value(), 100.0f);
+    ASSERT_FLOAT_EQ(archive.retrieve(5).value().maxTemp.value(), 3.0f)
+        << "The last duplicate within the batch was not kept";
+
+    const auto retrieveRangeData = archive.retrieveRange(0, 5);
+    ASSERT_EQ(retrieveRangeData.size(), 6);
+    for (auto i = 0; i < 6; ++i) {
+        ASSERT_EQ(retrieveRangeData[i].time.value(), i) << "Archive data is not sorted by time";
+    }
+}
+
+/** @brief Test retrieving the largest and smallest measurement within a range */
+TEST_F(WeatherArchiveTest, RetrieveExtremum) {
+    const int RangeLength = 200;
+
+    WeatherArchive archive;
+    std::vector<WeatherData> addedData;
+    for (auto i = 0; i < RangeLength; ++i) {
+        WeatherData newData;
+        newData.time = i;
+        // every seventh data point is missing maxTemp, values repeat so there are ties
+        if (i % 7 != 0) {
+            newData.maxTemp = static_cast<float>((i * 37) % 50);
+        }
+        archive.addData(newData);
+        addedData.push_back(newData);
+    }
+
+    // compare against a linear search for every range
+    for (auto first = 0; first < RangeLength; first += 3) {
+        for (auto last = first; last < RangeLength; last += 5) {
+            std::optional<WeatherData> expectedMax;
+            std::optional<WeatherData> expectedMin;
+            for (auto i = first; i <= last; ++i) {
+                const auto& value = addedData[i].maxTemp;
+                if (!value.has_value()) {
+                    continue;
+                }
+                if (!expectedMax.has_value() || value.value() > expectedMax.value().maxTemp.value()) {
+                    expectedMax = addedData[i];
+                }
+                if (!expectedMin.has_value() || value.value() < expectedMin.value().maxTemp.value()) {
+                    expectedMin = addedData[i];
+                }
+            }
+
+            ASSERT_EQ(archive.retrieveMax(WeatherData::Variable::MaxTemp, first, last), expectedMax)
+                << "WeatherArchive::retrieveMax returned the wrong data for range "
+                << first << " to " << last;
+            ASSERT_EQ(archive.retrieveMin(WeatherData::Variable::MaxTemp, first, last), expectedMin)
+                << "WeatherArchive::retrieveMin returned the wrong data for range "
+                << first << " to " << last;
+        }
+    }
+
+    ASSERT_FALSE(archive.retrieveMax(WeatherData::Variable::MaxTemp, 0, 0).has_value())
+        << "A range without the variable should not return data";
+    ASSERT_FALSE(archive.retrieveMax(WeatherData::Variable::MinTemp, 0, RangeLength).has_value())
+        << "A variable that is never measured should not return data";
+
+    // the index must be rebuilt after the archive changes
+    WeatherData hottest;
+    hottest.time = 10;
+    hottest.maxTemp = 1000.0f;
+    archive.addData(hottest);
+    ASSERT_EQ(archive.retrieveMax(WeatherData::Variable::MaxTemp, 0, RangeLength), hottest)
+        << "WeatherArchive::retrieveMax did not include data added after a query";
+}
+
+/** @brief Test that the calendar rollup is maintained as data is added and replaced */
+TEST_F(WeatherArchiveTest, Rollup) {
+    // 2015-12-01, so the first DJF season spans two calendar years
+    const WeatherData::data_time StartTime = 16770 * WeatherData::DaySeconds;
+    const int DayCount = 120;
+
+    auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        data.maxTemp = static_cast<float>(i);
+    }, StartTime);
+
+    auto months = archive.rollup().table(WeatherRollup::Period::Month);
+    ASSERT_EQ(months.size(), 4) << "Expected rows for 2015-12 through 2016-03";
+    ASSERT_EQ(months[0].year, 2015);
+    ASSERT_EQ(months[0].index, 12);
+    ASSERT_EQ(months[0].summary.count, 31);
+    const auto& december = months[0].summary.variable(WeatherData::Variable::MaxTemp);
+    ASSERT_EQ(december.count, 31);
+    ASSERT_FLOAT_EQ(december.min, 0.0f);
+    ASSERT_FLOAT_EQ(december.max, 30.0f);
+    ASSERT_DOUBLE_EQ(december.mean(), 15.0);
+    ASSERT_EQ(months[0].summary.variable(WeatherData::Variable::MinTemp).count, 0);
+
+    // replacing the December maximum must lower the maximum
+    WeatherData replaceData;
+    replaceData.time = StartTime + 30 * WeatherData::DaySeconds;
+    replaceData.maxTemp = -5.0f;
+    archive.addData(replaceData);
+    months = archive.rollup().table(WeatherRollup::Period::Month);
+    ASSERT_EQ(months[0].summary.count, 31) << "Replacing data changed the count";
+    ASSERT_FLOAT_EQ(months[0].summary.variable(WeatherData::Variable::MaxTemp).max, 29.0f)
+        << "Replacing data did not update the maximum";
+    ASSERT_FLOAT_EQ(months[0].summary.variable(WeatherData::Variable::MaxTemp).min, -5.0f)
+        << "Replacing data did not update the minimum";
+
+    const auto seasons = archive.rollup().table(WeatherRollup::Period::Season);
+    ASSERT_EQ(seasons.size(), 2) << "Expected rows for 2016 DJF and 2016 MAM";
+    ASSERT_EQ(seasons[0].year, 2016);
+    ASSERT_EQ(seasons[0].index, 0);
+    ASSERT_EQ(seasons[0].summary.count, 31 + 31 + 29) << "DJF should include the previous December";
+
+    const auto years = archive.rollup().table(WeatherRollup::Period::Year);
+    ASSERT_EQ(years.size(), 2);
+    ASSERT_EQ(years[0].summary.count + years[1].summary.count, DayCount);
+}
+
+/** @brief Test the climatological normals of a year range, and that they are cached */
+TEST_F(WeatherArchiveTest, Normals) {
+    // 2015-01-01 through 2016-12-31, 2016 is a leap year
+    const WeatherData::data_time StartTime = 16436 * WeatherData::DaySeconds;
+    const int DayCount = 365 + 366;
+
+    auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        data.maxTemp = (i < 365) ? 10.0f : 20.0f;
+        if (i % 2 == 0) {
+            data.gas_ppt = 1.0f;
+        }
+    }, StartTime);
+
+    const auto normals = archive.normals(2015, 2016);
+    ASSERT_EQ(normals->firstYear(), 2015);
+    ASSERT_EQ(normals->lastYear(), 2016);
+
+    const auto& march14 = normals->day(3, 14);
+    ASSERT_EQ(march14.count, 2) << "Expected March 14th of 2015 and 2016";
+    ASSERT_DOUBLE_EQ(march14.variable(WeatherData::Variable::MaxTemp).mean(), 15.0);
+    ASSERT_FLOAT_EQ(march14.variable(WeatherData::Variable::MaxTemp).min, 10.0f);
+    ASSERT_FLOAT_EQ(march14.variable(WeatherData::Variable::MaxTemp).max, 20.0f);
+    ASSERT_EQ(march14.variable(WeatherData::Variable::MinTemp).count, 0);
+
+    const auto& leapDay = normals->day(2, 29);
+    ASSERT_EQ(leapDay.count, 1) << "February 29th should only include 2016";
+    ASSERT_DOUBLE_EQ(leapDay.variable(WeatherData::Variable::MaxTemp).mean(), 20.0);
+
+    std::size_t totalCount = 0;
+    for (const auto& summary : normals->days()) {
+        totalCount += summary.count;
+    }
+    ASSERT_EQ(totalCount, DayCount);
+    ASSERT_THROW(normals->day(2, 30), std::out_of_range);
+
+    ASSERT_EQ(archive.normals(2016, 2016)->day(3, 14).count, 1)
+        << "Normals of a single year should only include that year";
+    ASSERT_EQ(archive.normals(2015, 2016), normals) << "Normals were not cached";
+
+    // adding data must invalidate the cached normals
+    WeatherData newData;
+    newData.time = StartTime + DayCount * WeatherData::DaySeconds;
+    archive.addData(newData);
+    ASSERT_NE(archive.normals(2015, 2016), normals) << "Normals were not rebuilt after adding data";
+}
+
+/** @brief Test that rolling window aggregates match a scan of each window, across gaps */
+TEST_F(WeatherArchiveTest, RetrieveRolling) {
+    const int DayCount = 200;
+    const int WindowDays = 7;
+
+    const auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        if (i >= 50 && i < 60) {
+            data.time.reset(); // gap longer than the window
+        } else if (i % 5 != 0) {
+            data.maxTemp = static_cast<float>((i * 37) % 23) - 11.0f;
+        }
+    });
+
+    const WeatherData::data_time beginTime = 3 * WeatherData::DaySeconds;
+    const WeatherData::data_time endTime = 150 * WeatherData::DaySeconds;
+    std::vector<WeatherData::data_time> times;
+    const auto visited = archive.retrieveRolling(
+            WeatherData::Variable::MaxTemp, WindowDays * WeatherData::DaySeconds, beginTime, endTime,
+            [&](const WeatherData::data_time time, const VariableSummary& summary) {
+                times.push_back(time);
+
+                VariableSummary expected;
+                for (const auto& data : archive.retrieveRange(
+                            time - (WindowDays - 1) * WeatherData::DaySeconds, time)) {
+                    if (data.maxTemp.has_value()) {
+                        expected.add(data.maxTemp.value());
+                    }
+                }
+
+                ASSERT_EQ(summary.count, expected.count) << "Count differs at " << time;
+                if (expected.count > 0) {
+                    ASSERT_NEAR(summary.mean(), expected.mean(), 1e-9) << "Mean differs at " << time;
+                    ASSERT_FLOAT_EQ(summary.min, expected.min) << "Min differs at " << time;
+                    ASSERT_FLOAT_EQ(summary.max, expected.max) << "Max differs at " << time;
+                }
+            });
+
+    ASSERT_EQ(visited, archive.retrieveRange(beginTime, endTime).size());
+    ASSERT_EQ(times.size(), visited);
+    ASSERT_EQ(times.front(), beginTime);
+    ASSERT_EQ(times.back(), endTime);
+}
+
+/** @brief Test that summarizing a range gives the same result for any number of threads */
+TEST_F(WeatherArchiveTest, SummarizeRange) {
+    const int DayCount = 5 * RangeReducer::BlockSize + 123;
+
+    VariableSummary expected;
+    const auto archive = buildArchive(DayCount, [&expected](const int i, WeatherData& data) {
+        if (i % 7 != 0) {
+            data.maxTemp = static_cast<float>((i * 7919) % 1000) / 7.0f;
+            if (i >= 10 && i <= DayCount - 10) {
+                expected.add(data.maxTemp.value());
+            }
+        }
+    }, 0, 1);
+
+    const auto summary = archive.summarizeRange(WeatherData::Variable::MaxTemp, 10, DayCount - 10);
+    ASSERT_EQ(summary.count, expected.count);
+    ASSERT_NEAR(summary.sum, expected.sum, 1e-6 * std::abs(expected.sum));
+    ASSERT_FLOAT_EQ(summary.min, expected.min);
+    ASSERT_FLOAT_EQ(summary.max, expected.max);
+
+    for (const std::size_t threads : {2, 3, 8}) {
+        const auto threadSummary = archive.summarizeRange(
+                WeatherData::Variable::MaxTemp, 10, DayCount - 10, threads);
+        ASSERT_EQ(threadSummary.count, summary.count);
+        ASSERT_EQ(threadSummary.sum, summary.sum)
+            << "The sum using " << threads << " threads is not bit for bit reproducible";
+        ASSERT_EQ(threadSummary.min, summary.min);
+        ASSERT_EQ(threadSummary.max, summary.max);
+    }
+
+    ASSERT_EQ(archive.summarizeRange(WeatherData::Variable::MinTemp, 0, DayCount, 4).count, 0);
+    ASSERT_EQ(archive.summarizeRange(WeatherData::Variable::MaxTemp, DayCount, 0, 4).count, 0);
+}
+
+/** @brief Test exact percentiles of short ranges, and estimated percentiles of long ranges */
+TEST_F(WeatherArchiveTest, RetrievePercentile) {
+    const int DayCount = 20000;
+
+    const auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        if (i % 10 != 0) {
+            // a permutation of 0 to DayCount - 1
+            data.maxTemp = static_cast<float>((i * 7919) % DayCount);
+        }
+    });
+
+    // short range, answered exactly
+    std::vector<float> shortValues;
+    for (const auto& data : archive.retrieveRange(100 * WeatherData::DaySeconds, 300 * WeatherData::DaySeconds)) {
+        if (data.maxTemp.has_value()) {
+            shortValues.push_back(data.maxTemp.value());
+        }
+    }
+    std::sort(shortValues.begin(), shortValues.end());
+    const auto exactMedian = archive.retrievePercentile(
+            WeatherData::Variable::MaxTemp, 50, 100 * WeatherData::DaySeconds, 300 * WeatherData::DaySeconds);
+    ASSERT_TRUE(exactMedian.has_value());
+    ASSERT_FLOAT_EQ(exactMedian.value(), shortValues[(shortValues.size() + 1) / 2 - 1]);
+    ASSERT_FLOAT_EQ(archive.retrievePercentile(
+                WeatherData::Variable::MaxTemp, 0, 100 * WeatherData::DaySeconds, 300 * WeatherData::DaySeconds).value(),
+            shortValues.front());
+    ASSERT_FLOAT_EQ(archive.retrievePercentile(
+                WeatherData::Variable::MaxTemp, 100, 100 * WeatherData::DaySeconds, 300 * WeatherData::DaySeconds).value(),
+            shortValues.back());
+
+    // long range, estimated from monthly sketches
+    std::vector<float> longValues;
+    for (const auto& data : archive.retrieveRange(15 * WeatherData::DaySeconds, (DayCount - 15) * WeatherData::DaySeconds)) {
+        if (data.maxTemp.has_value()) {
+            longValues.push_back(data.maxTemp.value());
+        }
+    }
+    std::sort(longValues.begin(), longValues.end());
+    for (const double percentile : {5.0, 50.0, 95.0}) {
+        const auto estimate = archive.retrievePercentile(WeatherData::Variable::MaxTemp,
+                percentile, 15 * WeatherData::DaySeconds, (DayCount - 15) * WeatherData::DaySeconds);
+        ASSERT_TRUE(estimate.has_value());
+        const auto rank = std::lower_bound(longValues.cbegin(), longValues.cend(), estimate.value())
+            - longValues.cbegin();
+        const auto expectedRank = percentile / 100.0 * longValues.size();
+        ASSERT_NEAR(rank, expectedRank, 0.01 * longValues.size())
+            << "The estimated " << percentile << "th percentile is more than 1% of the rank off";
+    }
+
+    ASSERT_FALSE(archive.retrievePercentile(
+                WeatherData::Variable::MinTemp, 50, 0, DayCount * WeatherData::DaySeconds).has_value());
+}
+
+/** @brief Test that threshold counts and matches agree with a scan of the range */
+TEST_F(WeatherArchiveTest, CountWhere) {
+    // more than one bitmap chunk, with a value repeated often
+    const int DayCount = 150000;
+
+    const auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        if (i % 11 != 0) {
+            data.maxTemp = static_cast<float>((i * 7919) % 500) / 10.0f - 10.0f;
+            data.gas_ppt = (i % 3 == 0) ? 0.0f : static_cast<float>(i % 17);
+        }
+    }, 0, 1);
+
+    using Comparison = ValueBitmapIndex::Comparison;
+    const auto compare = [](const Comparison comparison, const float value, const float threshold) {
+        switch (comparison) {
+        case Comparison::Less: return value < threshold;
+        case Comparison::LessEqual: return value <= threshold;
+        case Comparison::Equal: return value == threshold;
+        case Comparison::GreaterEqual: return value >= threshold;
+        case Comparison::Greater: return value > threshold;
+        }
+        return false;
+    };
+
+    const WeatherData::data_time beginTime = 1234;
+    const WeatherData::data_time endTime = 140000;
+    const auto rangeData = archive.retrieveRange(beginTime, endTime);
+    for (const auto comparison : {Comparison::Less, Comparison::LessEqual, Comparison::Equal,
+            Comparison::GreaterEqual, Comparison::Greater}) {
+        for (const auto& [variable, threshold] : {
+                std::make_pair(WeatherData::Variable::MaxTemp, 35.0f),
+                std::make_pair(WeatherData::Variable::MaxTemp, -100.0f),
+                std::make_pair(WeatherData::Variable::MaxTemp, 12.3f),
+                std::make_pair(WeatherData::Variable::GasPpt, 0.0f)}) {
+            std::vector<WeatherData> expected;
+            for (const auto& data : rangeData) {
+                if (data.value(variable).has_value()
+                        && compare(comparison, data.value(variable).value(), threshold)) {
+                    expected.push_back(data);
+                }
+            }
+
+            ASSERT_EQ(archive.countWhere(variable, comparison, threshold, beginTime, endTime),
+                    expected.size()) << "Count differs for threshold " << threshold;
+            ASSERT_EQ(archive.retrieveWhere(variable, comparison, threshold, beginTime, endTime),
+                    expected) << "Matches differ for threshold " << threshold;
+        }
+    }
+
+    ASSERT_EQ(archive.countWhere(WeatherData::Variable::MinTemp,
+                Comparison::GreaterEqual, -100.0f, 0, DayCount), 0);
+}
+
+/** @brief Test that the top K data points match sorting the range, for short and long ranges */
+TEST_F(WeatherArchiveTest, RetrieveTop) {
+    const int DayCount = 5000;
+
+    const auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        if (i % 9 != 0) {
+            data.maxTemp = static_cast<float>((i * 7919) % 300); // values repeat, test ties
+        }
+    }, 0, 1);
+
+    for (const auto extremum : {RangeExtremumIndex::Extremum::Max, RangeExtremumIndex::Extremum::Min}) {
+        for (const auto& [beginTime, endTime] : {std::make_pair(100, 150), std::make_pair(10, 4990)}) {
+            auto expected = archive.retrieveRange(beginTime, endTime);
+            expected.erase(std::remove_if(expected.begin(), expected.end(),
+                        [](const WeatherData& data) { return !data.maxTemp.has_value(); }),
+                    expected.end());
+            std::stable_sort(expected.begin(), expected.end(),
+                    [extremum](const WeatherData& lhs, const WeatherData& rhs) {
+                        return (extremum == RangeExtremumIndex::Extremum::Max) ?
+                            lhs.maxTemp.value() > rhs.maxTemp.value() :
+                            lhs.maxTemp.value() < rhs.maxTemp.value();
+                    });
+            expected.resize(10);
+
+            ASSERT_EQ(archive.retrieveTop(
+                        WeatherData::Variable::MaxTemp, 10, beginTime, endTime, extremum), expected)
+                << "Top 10 differs for the range " << beginTime << " to " << endTime;
+        }
+    }
+
+    ASSERT_EQ(archive.retrieveTop(WeatherData::Variable::MaxTemp, 100, 0, 8).size(), 8)
+        << "Expected every data point within the range with the variable";
+    ASSERT_TRUE(archive.retrieveTop(WeatherData::Variable::MinTemp, 10, 0, DayCount).empty());
+}
+
+/** @brief Test that runs of days meeting a condition are found, and end at missing days */
+TEST_F(WeatherArchiveTest, RetrieveRuns) {
+    // tmax of each day, NaN is a day missing tmax, and day 12 is missing entirely
+    const std::vector<float> MaxTemps {
+        30, 36, 37, 39, 36, 20, 36, 37, NAN, 36, 38, 40, 0, 37, 36, 35.5, 41};
+
+    const auto archive = buildArchive(static_cast<int>(MaxTemps.size()),
+            [&MaxTemps](const int i, WeatherData& data) {
+        if (i == 12) {
+            data.time.reset();
+        } else if (!std::isnan(MaxTemps[i])) {
+            data.maxTemp = MaxTemps[i];
+        }
+    });
+
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t, float>> runs;
+    const auto runCount = archive.retrieveRuns(WeatherData::Variable::MaxTemp,
+            ValueBitmapIndex::Comparison::Greater, 35.0f, 3, 0, 100 * WeatherData::DaySeconds,
+            [&](const WeatherData& first, const WeatherData& last,
+                const WeatherData& peak, const std::size_t length) {
+                runs.emplace_back(first.time.value() / WeatherData::DaySeconds, last.time.value() / WeatherData::DaySeconds,
+                        length, peak.maxTemp.value());
+            });
+
+    // days 6-7 are too short, days 9-11 end at the missing day 12
+    const std::vector<std::tuple<std::size_t, std::size_t, std::size_t, float>> expected {
+        {1, 4, 4, 39.0f}, {9, 11, 3, 40.0f}, {13, 16, 4, 41.0f}};
+    ASSERT_EQ(runCount, expected.size());
+    ASSERT_EQ(runs, expected);
+
+    // a run is cut off at the end of the range, the peak of a dry spell is its minimum
+    std::size_t cutLength = 0;
+    float cutPeak = 0;
+    archive.retrieveRuns(WeatherData::Variable::MaxTemp,
+            ValueBitmapIndex::Comparison::Less, 38.0f, 1, 13 * WeatherData::DaySeconds, 15 * WeatherData::DaySeconds,
+            [&](const WeatherData&, const WeatherData&, const WeatherData& peak, const std::size_t length) {
+                cutLength = length;
+                cutPeak = peak.maxTemp.value();
+            });
+    ASSERT_EQ(cutLength, 3);
+    ASSERT_FLOAT_EQ(cutPeak, 35.5f);
+}
+
+/** @brief Test degree day totals against a scan of the range, including the tmean fallback */
+TEST_F(WeatherArchiveTest, RetrieveDegreeDays) {
+    const int DayCount = 800;
+    const float Base = 18.0f;
+
+    const auto archive = buildArchive(DayCount, [](const int i, WeatherData& data) {
+        const auto temperature = static_cast<float>((i * 37) % 41) - 5.0f;
+        if (i % 4 == 1) {
+            // no tmean, fall back to the average of tmax and tmin
+            data.maxTemp = temperature + 3.0f;
+            data.minTemp = temperature - 3.0f;
+        } else if (i % 4 == 2) {
+            data.maxTemp = temperature; // no temperature at all
+        } else {
+            data.meanTemp = temperature;
+        }
+    });
+
+    for (const auto& [beginDay, endDay] : {std::make_pair(0, DayCount), std::make_pair(17, 20),
+            std::make_pair(45, 700)}) {
+        double heating = 0;
+        double cooling = 0;
+        std::size_t count = 0;
+        for (const auto& data : archive.retrieveRange(beginDay * WeatherData::DaySeconds, endDay * WeatherData::DaySeconds)) {
+            std::optional<float> temperature = data.meanTemp;
+            if (!temperature.has_value() && data.maxTemp.has_value() && data.minTemp.has_value()) {
+                temperature = (data.maxTemp.value() + data.minTemp.value()) / 2;
+            }
+            if (temperature.has_value()) {
+                heating += std::max(0.0f, Base - temperature.value());
+                cooling += std::max(0.0f, temperature.value() - Base);
+                ++count;
+            }
+        }
+
+        const auto degreeDays = archive.retrieveDegreeDays(
+                Base, beginDay * WeatherData::DaySeconds, endDay * WeatherData::DaySeconds);
+        ASSERT_EQ(degreeDays.count, count);
+        ASSERT_NEAR(degreeDays.heating, heating, 1e-6 * (1 + heating));
+        ASSERT_NEAR(degreeDays.cooling, cooling, 1e-6 * (1 + cooling));
+    }
+
+    // more bases than are cached, the evicted bases are rebuilt with the same totals
+    const auto expected = archive.retrieveDegreeDays(Base, 0, DayCount * WeatherData::DaySeconds);
+    for (auto base = 0; base < 100; ++base) {
+        const auto degreeDays = archive.retrieveDegreeDays(
+                static_cast<float>(base) / 4.0f, 0, DayCount * WeatherData::DaySeconds);
+        ASSERT_EQ(degreeDays.count, expected.count);
+    }
+    const auto rebuilt = archive.retrieveDegreeDays(Base, 0, DayCount * WeatherData::DaySeconds);
+    ASSERT_EQ(rebuilt.heating, expected.heating);
+    ASSERT_EQ(rebuilt.cooling, expected.cooling);
+}
+
+/** @brief Test that historical samples are reproducible, independent of the thread count,
+ * and taken from the same calendar day of a year within the range */
+TEST_F(WeatherArchiveTest, SampleHistory) {
+    // 1970-01-01 to 1979-12-31, with the value of tmax the year of the data
+    const auto archive = buildArchive(3652, [](const int day, WeatherData& data) {
+        const date::year_month_day ymd{date::sys_days{date::days{day}}};
+        data.maxTemp = static_cast<float>(static_cast<int>(ymd.year()));
+    });
+
+    // 10000 days beginning 2000-01-01, sampled from 1972-1975
+    const WeatherData::data_time begin = 10957 * WeatherData::DaySeconds;
+    const WeatherData::data_time end = begin + 9999 * WeatherData::DaySeconds;
+    const auto sampled = archive.sampleHistory(begin, end, 1972, 1975, 42);
+    ASSERT_EQ(sampled.size(), 10000u);
+    for (std::size_t i = 0; i < sampled.size(); ++i) {
+        ASSERT_EQ(sampled[i].time.value(), begin + static_cast<WeatherData::data_time>(i) * WeatherData::DaySeconds);
+        const auto year = static_cast<int>(sampled[i].maxTemp.value());
+        ASSERT_GE(year, 1972);
+        ASSERT_LE(year, 1975);
+
+        // the sample is the same calendar day, and February 29th is only in 1972
+        const date::year_month_day ymd{date::floor<date::days>(
+                date::sys_seconds{std::chrono::seconds{sampled[i].time.value()}})};
+        const auto source = archive.retrieve(std::chrono::duration_cast<std::chrono::seconds>(
+                    date::sys_days{date::year{year}/ymd.month()/ymd.day()}.time_since_epoch()).count());
+        ASSERT_TRUE(source.has_value());
+        if (ymd.month() == date::February && ymd.day() == date::day{29}) {
+            ASSERT_EQ(year, 1972);
+        }
+    }
+
+    // every year is sampled
+    for (auto year = 1972; year <= 1975; ++year) {
+        ASSERT_TRUE(std::any_of(sampled.cbegin(), sampled.cend(), [year](const WeatherData& data) {
+                    return data.maxTemp.value() == static_cast<float>(year);
+                }));
+    }
+
+    // the same seed gives the same samples for any number of threads, another seed does not
+    ASSERT_EQ(archive.sampleHistory(begin, end, 1972, 1975, 42, 4), sampled);
+    ASSERT_NE(archive.sampleHistory(begin, end, 1972, 1975, 43), sampled);
+
+    // members of an ensemble are independent, member 0 is the default
+    ASSERT_EQ(archive.sampleHistory(begin, end, 1972, 1975, 42, 1, 0), sampled);
+    ASSERT_NE(archive.sampleHistory(begin, end, 1972, 1975, 42, 1, 1), sampled);
+    ASSERT_EQ(archive.sampleHistory(begin, end, 1972, 1975, 42, 4, 1),
+            archive.sampleHistory(begin, end, 1972, 1975, 42, 1, 1));
+
+    // dates without data in the year range are omitted
+    ASSERT_TRUE(archive.sampleHistory(begin, end, 1990, 1995, 42).empty());
+}
+
+/** @brief Test that block bootstrap samples follow consecutive days of the same year,
+ * and sample a date on its own when the following day is missing */
+TEST_F(WeatherArchiveTest, SampleHistoryBlocks) {
+    const std::size_t BlockLength = 7;
+
+    // 1970-01-01 to 1979-12-31, with tmin the day number of the data, and 1975-06-10 missing
+    const auto missingDay = date::sys_days{date::year{1975}/6/10}.time_since_epoch().count();
+    const auto archive = buildArchive(3652, [missingDay](const int day, WeatherData& data) {
+        if (day == missingDay) {
+            data.time.reset();
+        } else {
+            data.minTemp = static_cast<float>(day);
+        }
+    });
+
+    const WeatherData::data_time begin = 10957 * WeatherData::DaySeconds; // 2000-01-01
+    const WeatherData::data_time end = begin + 9999 * WeatherData::DaySeconds;
+    const auto sampled = archive.sampleHistory(begin, end, 1970, 1979, 7, 1, 0, BlockLength);
+    ASSERT_EQ(sampled.size(), 10000u);
+
+    // each date of a block takes the day following the first day of the block, unless
+    // that day is missing or after the year range
+    std::size_t followed = 0;
+    for (std::size_t i = 0; i < sampled.size(); ++i) {
+        const auto blockDay = static_cast<long>(sampled[i - i % BlockLength].minTemp.value());
+        const auto followingDay = blockDay + static_cast<long>(i % BlockLength);
+        if (followingDay != missingDay && followingDay < 3652) {
+            ASSERT_EQ(sampled[i].minTemp.value(), static_cast<float>(followingDay));
+            ++followed;
+        }
+    }
+    ASSERT_GT(followed, 9900u);
+
+    // blocks are reproducible for any number of threads, and a block length of 1 samples
+    // every day on its own
+    ASSERT_EQ(archive.sampleHistory(begin, end, 1970, 1979, 7, 4, 0, BlockLength), sampled);
+    ASSERT_EQ(archive.sampleHistory(begin, end, 1970, 1979, 7, 1, 0, 1),
+            archive.sampleHistory(begin, end, 1970, 1979, 7));
+}
+
+/** @brief Test that weighted years are drawn in proportion to their weights */
+TEST_F(WeatherArchiveTest, SampleHistoryWeighted) {
+    // 1970-01-01 to 1979-12-31, with the value of tmax the year of the data
+    const auto archive = buildArchive(3652, [](const int day, WeatherData& data) {
+        const date::year_month_day ymd{date::sys_days{date::days{day}}};
+        data.maxTemp = static_cast<float>(static_cast<int>(ymd.year()));
+    });
+
+    // 1972 (a leap year) has weight 1, 1973 and 1974 are never drawn, 1975 has weight 3
+    const std::vector<double> weights {1, 0, 0, 3};
+    const WeatherData::data_time begin = 10957 * WeatherData::DaySeconds; // 2000-01-01
+    const WeatherData::data_time end = begin + 39999 * WeatherData::DaySeconds;
+    const auto sampled = archive.sampleHistory(begin, end, 1972, 1975, 5, 1, 0, 1, weights);
+    ASSERT_EQ(sampled.size(), 40000u);
+
+    std::array<std::size_t, 4> counts {};
+    for (const auto& data : sampled) {
+        ++counts[static_cast<std::size_t>(data.maxTemp.value()) - 1972];
+    }
+    ASSERT_EQ(counts[1], 0u);
+    ASSERT_EQ(counts[2], 0u);
+    const auto share = static_cast<double>(counts[3]) / sampled.size();
+    ASSERT_NEAR(share, 0.75, 0.02);
+
+    // reproducible for any number of threads, and an unweighted sampler is not reused
+    ASSERT_EQ(archive.sampleHistory(begin, end, 1972, 1975, 5, 4, 0, 1, weights), sampled);
+    ASSERT_NE(archive.sampleHistory(begin, end, 1972, 1975, 5), sampled);
+
+    // February 29th can only be drawn from 1972, without it the date is omitted
+    const auto leapDay = date::sys_days{date::year{2000}/2/29}.time_since_epoch().count() * WeatherData::DaySeconds;
+    ASSERT_EQ(archive.sampleHistory(leapDay, leapDay, 1972, 1975, 5, 1, 0, 1, weights).size(), 1u);
+    ASSERT_TRUE(archive.sampleHistory(leapDay, leapDay, 1972, 1975, 5, 1, 0, 1, {0, 1, 1, 1}).empty());
+}
+
+/** @brief Test ensemble bands against the quantiles of the sampled members */
+TEST_F(WeatherArchiveTest, SampleBands) {
+    const std::size_t MemberCount = 50;
+
+    // 1970-01-01 to 1989-12-31, tmax is a different value every day, some days miss it
+    const auto archive = buildArchive(7305, [](const int day, WeatherData& data) {
+        if (day % 11 != 0) {
+            data.maxTemp = static_cast<float>((day * 7919) % 1000) / 10.0f;
+        }
+    });
+
+    const WeatherData::data_time begin = 10957 * WeatherData::DaySeconds; // 2000-01-01
+    const WeatherData::data_time end = begin + 99 * WeatherData::DaySeconds;
+    const auto bands = archive.sampleBands(WeatherData::Variable::MaxTemp, MemberCount,
+            begin, end, 1970, 1989, 3, 1, 5);
+    ASSERT_EQ(bands.size(), 100u);
+
+    // the members are small enough to be kept exactly by the sketches
+    std::vector<std::vector<float>> values(bands.size());
+    for (std::size_t member = 0; member < MemberCount; ++member) {
+        for (const auto& data : archive.sampleHistory(begin, end, 1970, 1989, 3, 1, member, 5)) {
+            if (data.maxTemp.has_value()) {
+                values[static_cast<std::size_t>((data.time.value() - begin) / WeatherData::DaySeconds)]
+                    .push_back(data.maxTemp.value());
+            }
+        }
+    }
+    for (std::size_t day = 0; day < bands.size(); ++day) {
+        ASSERT_EQ(bands[day].count(), values[day].size());
+        std::sort(values[day].begin(), values[day].end());
+        ASSERT_EQ(bands[day].quantile(0.5).value(),
+                values[day][static_cast<std::size_t>(std::ceil(0.5 * values[day].size())) - 1]);
+        ASSERT_EQ(bands[day].quantile(1).value(), values[day].back());
+    }
+
+    // the groups of members are merged in order, for any number of threads
+    const auto threaded = archive.sampleBands(WeatherData::Variable::MaxTemp, MemberCount,
+            begin, end, 1970, 1989, 3, 4, 5);
+    for (std::size_t day = 0; day < bands.size(); ++day) {
+        for (const auto fraction : {0.1, 0.5, 0.9}) {
+            ASSERT_EQ(threaded[day].quantile(fraction), bands[day].quantile(fraction));
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file weather_file_index_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for WeatherFileIndex class
+ */
+
+#include "weather_file_index.h"
+#include "json_parse.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * @class WeatherFileIndexTest weather_file_index_test.cpp "test/weather_file_index_test.cpp"
+ * @brief This class tests indexing and lazily parsing JSON weather data files
+ */
+class WeatherFileIndexTest : public ::testing::Test {
+protected:
+
+    WeatherFileIndexTest() {}
+
+    ~WeatherFileIndexTest() override {}
+
+    void SetUp() override {
+        mFilename = (std::filesystem::temp_directory_path() / 
+                ("weather_file_index_test_" + std::to_string(::testing::UnitTest::GetInstance()
+                    ->random_seed()) + ".json")).string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(mFilename);
+        std::filesystem::remove(WeatherFileIndex::sidecarFilename(mFilename));
+    }
+
+    /** @brief Write the test JSON file */
+    void writeFile(const std::string& contents) {
+        std::ofstream file(mFilename, std::ios::trunc);
+        file << contents;
+    }
+
+    std::string mFilename; /**<@brief Path to the JSON file used by the test */
+
+}; // WeatherFileIndexTest
+
+/** @brief JSON data that is out of order, with a duplicate date and a missing date */
+const std::string UnsortedJson{
+    "[\n"
+    "{\"date\": \"2016-03-03\", \"tmax\": 3.0, \"note\": \"}{ \\\" date\"},\n"
+    "{\"date\": \"2016-03-01\", \"tmax\": 1.0},\n"
+    "{\"tmax\": 99.0},\n"
+    "{\"date\": \"2016-03-02\", \"tmax\": 2.0},\n"
+    "{\"tmax\": 4.0, \"date\": \"2016-03-01\"}\n"
+    "]\n"};
+
+/** @brief Test building an index, and parsing data using it */
+TEST_F(WeatherFileIndexTest, BuildAndRetrieve) {
+    writeFile(UnsortedJson);
+
+    const auto index = WeatherFileIndex::build(mFilename);
+    ASSERT_EQ(index.entries().size(), 3) << "Objects without a date should not be indexed, "
+        "and duplicate dates should be indexed once";
+    ASSERT_FALSE(index.fileSorted());
+
+    const auto day = jsonparse::dateToUnix("2016-03-01").value();
+    const auto dataOpt = index.retrieve(day);
+    ASSERT_TRUE(dataOpt.has_value()) << "WeatherFileIndex::retrieve did not find the data";
+    ASSERT_FLOAT_EQ(dataOpt.value().maxTemp.value(), 4.0f)
+        << "The last object with a duplicated date should be used";
+
+    ASSERT_FALSE(index.retrieve(jsonparse::dateToUnix("2016-03-04").value()).has_value())
+        << "WeatherFileIndex::retrieve returned data that is not in the file";
+
+    const auto rangeData = index.retrieveRange(day, jsonparse::dateToUnix("2016-03-05").value());
+    ASSERT_EQ(rangeData.size(), 3);
+    ASSERT_FLOAT_EQ(rangeData[1].maxTemp.value(), 2.0f);
+    ASSERT_FLOAT_EQ(rangeData[2].maxTemp.value(), 3.0f)
+        << "Characters within strings should not affect finding objects";
+}
+
+/** @brief Test indexing a file that contains a single object */
+TEST_F(WeatherFileIndexTest, SingleObject) {
+    writeFile("{\"date\": \"2016-03-03\", \"tmin\": -1.5}");
+
+    const auto index = WeatherFileIndex::build(mFilename);
+    ASSERT_EQ(index.entries().size(), 1);
+    ASSERT_TRUE(index.fileSorted());
+
+    const auto dataOpt = index.retrieve(jsonparse::dateToUnix("2016-03-03").value());
+    ASSERT_TRUE(dataOpt.has_value());
+    ASSERT_FLOAT_EQ(dataOpt.value().minTemp.value(), -1.5f);
+}
+
+/** @brief Test that files that are not arrays of objects are rejected */
+TEST_F(WeatherFileIndexTest, InvalidFile) {
+    writeFile("[1, 2, 3]");
+    ASSERT_THROW(WeatherFileIndex::build(mFilename), jsonparse::IncorrectJson);
+
+    writeFile("[{\"date\": \"2016-03-03\"");
+    ASSERT_THROW(WeatherFileIndex::build(mFilename), jsonparse::IncorrectJson);
+}
+
+/** @brief Test saving and loading the sidecar index file */
+TEST_F(WeatherFileIndexTest, Sidecar) {
+    writeFile(UnsortedJson);
+    ASSERT_FALSE(WeatherFileIndex::loadSidecar(mFilename).has_value())
+        << "A sidecar should not exist before it is saved";
+
+    const auto index = WeatherFileIndex::loadOrBuild(mFilename);
+    ASSERT_TRUE(std::filesystem::exists(WeatherFileIndex::sidecarFilename(mFilename)))
+        << "WeatherFileIndex::loadOrBuild did not save the sidecar";
+
+    const auto loadedIndex = WeatherFileIndex::loadSidecar(mFilename);
+    ASSERT_TRUE(loadedIndex.has_value()) << "The saved sidecar could not be loaded";
+    ASSERT_EQ(loadedIndex.value().fileSorted(), index.fileSorted());
+    ASSERT_EQ(loadedIndex.value().entries().size(), index.entries().size());
+    for (std::size_t i = 0; i < index.entries().size(); ++i) {
+        ASSERT_EQ(loadedIndex.value().entries()[i].time, index.entries()[i].time);
+        ASSERT_EQ(loadedIndex.value().entries()[i].offset, index.entries()[i].offset);
+        ASSERT_EQ(loadedIndex.value().entries()[i].length, index.entries()[i].length);
+    }
+
+    // changing the JSON file makes the sidecar stale
+    writeFile(UnsortedJson + " ");
+    ASSERT_FALSE(WeatherFileIndex::loadSidecar(mFilename).has_value())
+        << "A stale sidecar should not be loaded";
+}
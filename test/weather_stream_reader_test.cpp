@@ -0,0 +1,73 @@
+/**
+ * @file weather_stream_reader_test.cpp
+ * @date 10/16/2026
+ *
+ * @brief Unit test for WeatherStreamReader class
+ */
+
+#include "weather_stream_reader.h"
+#include "json_parse.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class WeatherStreamReaderTest weather_stream_reader_test.cpp "test/weather_stream_reader_test.cpp"
+ * @brief This class tests range queries on streams of JSON weather data
+ */
+class WeatherStreamReaderTest : public ::testing::Test {
+protected:
+
+    WeatherStreamReaderTest() {}
+
+    ~WeatherStreamReaderTest() override {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+}; // WeatherStreamReaderTest
+
+/** @brief Test visiting the data within a range of an unsorted stream */
+TEST_F(WeatherStreamReaderTest, ReadRange) {
+    std::istringstream input{
+        "[{\"date\": \"2016-03-03\", \"tmax\": 3.0},"
+        "{\"date\": \"2016-03-01\", \"tmax\": 1.0},"
+        "{\"tmax\": 99.0},"
+        "{\"date\": \"2016-03-05\", \"tmax\": 5.0},"
+        "{\"date\": \"2016-03-02\", \"tmax\": 2.0}]"};
+
+    std::vector<WeatherData> visited;
+    WeatherStreamReader reader(input, false);
+    const auto count = reader.readRange(
+            jsonparse::dateToUnix("2016-03-02").value(),
+            jsonparse::dateToUnix("2016-03-04").value(),
+            [&visited](const WeatherData& data) { visited.push_back(data); });
+
+    ASSERT_EQ(count, 2);
+    ASSERT_EQ(visited.size(), 2);
+    ASSERT_FLOAT_EQ(visited[0].maxTemp.value(), 3.0f) << "Data should be visited in stream order";
+    ASSERT_FLOAT_EQ(visited[1].maxTemp.value(), 2.0f) << "Data should be visited in stream order";
+}
+
+/** @brief Test that a sorted stream stops scanning once it passes the range */
+TEST_F(WeatherStreamReaderTest, ReadSortedRange) {
+    // the data after the range is not valid, so the scan must stop before it
+    std::istringstream input{
+        "[{\"date\": \"2016-03-01\", \"tmax\": 1.0},"
+        "{\"date\": \"2016-03-02\", \"tmax\": 2.0},"
+        "{\"date\": \"2016-03-03\", \"tmax\": 3.0},"
+        "not json"};
+
+    std::vector<WeatherData> visited;
+    WeatherStreamReader reader(input, true);
+    ASSERT_NO_THROW({
+        reader.readRange(
+                jsonparse::dateToUnix("2016-03-01").value(),
+                jsonparse::dateToUnix("2016-03-02").value(),
+                [&visited](const WeatherData& data) { visited.push_back(data); });
+    }) << "The scan of a sorted stream did not stop after the range";
+    ASSERT_EQ(visited.size(), 2);
+}